@@ -0,0 +1,284 @@
+/**
+ * @file 	adc_test.c
+ * @author	Zac Carico
+ * @date 	Oct 16 2026
+ *
+ * @brief	Function definitions of adc_test.h
+ */
+
+#include "adc_test.h"
+#include "uart_printf.h"
+
+/** @brief Names of each ADC_OFFLOAD */
+static const char * const adc_offload_names[NUM_ADC_OFFLOAD] = {
+	"Core16550",
+	"FRAM"
+};
+
+/** @brief Object for CoreTimer0, the sample clock */
+static timer_instance_t adc_timer;
+
+/** @brief Stream shared with "External_30_IRQHandler()" */
+static adc_stream_t adc_stream;
+
+static uint32_t adc_offload(ADC_OFFLOAD offload, const uint8_t *data, uint32_t length, uint32_t *framAddress);
+
+/**
+ * @brief	The main function of the ADC test. Asks for the sample rate,
+ * 			channels and offload, then streams until a key is pressed.
+ */
+void adc_test_handler(void)
+{
+	uint32_t rate = 0;
+	uint32_t channels = 0;
+	uint32_t offload = 0;
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\rWELCOME TO THE ADC TEST!\n\r");
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tSample rate in Hz (1-50000):\n\r");
+	rate = get_dec_from_user(5);
+	if(rate == 0 || rate > ADC_MAX_RATE_HZ)
+		rate = 1000;
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tChannels to sample in turn (1-8):\n\r");
+	channels = get_dec_from_user(1);
+	if(channels == 0 || channels > ADC_NUM_CHANNELS)
+		channels = 1;
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tOffload to (0 = Core16550, 1 = FRAM):\n\r");
+	offload = get_dec_from_user(1);
+	if(offload >= NUM_ADC_OFFLOAD)
+		offload = ADC_OFFLOAD_UART;
+
+	// Brings up riscv_spi and g_fram
+	spi_test_init();
+	adc_test_stream(rate, (uint8_t)channels, (ADC_OFFLOAD)offload);
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\rLeaving ADC Test Program\n\r");
+}
+
+/**
+ * @brief	Samples the ADC at a fixed rate and offloads full buffers
+ * 			until a key is pressed on the console
+ *
+ * @details	The main loop only waits for a full buffer and offloads it,
+ * 			a chunk at a time so the console key is still seen. Once a
+ * 			second the achieved sample rate, the largest and mean error
+ * 			of the sample intervals and the dropped samples are printed.
+ *
+ * @param rateHz	Samples per second, up to ADC_MAX_RATE_HZ
+ * @param channels	Channels 0 to channels - 1 are sampled in turn
+ * @param offload	Where full buffers go
+ */
+void adc_test_stream(uint32_t rateHz, uint8_t channels, ADC_OFFLOAD offload)
+{
+	const uint8_t *pending = NULL;
+	uint32_t pendingLength = 0;
+	uint32_t framAddress = 0;
+	uint32_t buffersOffloaded = 0;
+	uint32_t lastSamples = 0;
+	uint32_t lastDropped = 0;
+	uint32_t intervalStart = 0;
+	uint32_t elapsed = 0;
+	uint32_t samples = 0;
+	uint32_t dropped = 0;
+	uint32_t maxJitter = 0;
+	uint32_t jitterSum = 0;
+	uint8_t offloadBuffer = 0;
+	uint8_t key = 0;
+	psr_t saved_psr;
+
+	memset(&adc_stream, 0, sizeof(adc_stream));
+	adc_stream.channels = channels;
+	adc_stream.expectedCycles = SYS_CLK_FREQ / rateHz;
+
+	if(offload == ADC_OFFLOAD_UART)
+		UART_16550_set_loopback(&g_uart_16550, 0);
+
+	uart_printf("\n\r\t%u Hz on %u channel(s) to %s, press any key to stop\n\r", rateHz, channels,
+				adc_offload_names[offload]);
+	UART_tx_flush(&g_uart);
+
+	TMR_init(&adc_timer, CORETIMER0_BASE_ADDR, TMR_CONTINUOUS_MODE, ADC_TIMER_PRESCALE,
+			 (ADC_TIMER_CLK_FREQ / rateHz) - 1u);
+	saved_psr = HAL_disable_interrupts();
+	PLIC_SetPriority(TIMER0_IRQn, 3);
+	PLIC_EnableIRQ(TIMER0_IRQn);
+	HAL_restore_interrupts(saved_psr);
+	TMR_enable_int(&adc_timer);
+	TMR_start(&adc_timer);
+
+	intervalStart = get_cycle_count();
+	while(UART_get_rx(&g_uart, &key, 1) == 0)
+	{
+		if(pending == NULL && adc_stream.full[offloadBuffer])
+		{
+			pending = (const uint8_t *)adc_stream.buffers[offloadBuffer];
+			pendingLength = sizeof(adc_stream.buffers[0]);
+		}
+
+		if(pending != NULL)
+		{
+			uint32_t count = adc_offload(offload, pending, pendingLength, &framAddress);
+			pending += count;
+			pendingLength -= count;
+			if(pendingLength == 0)
+			{
+				pending = NULL;
+				adc_stream.full[offloadBuffer] = 0;
+				offloadBuffer ^= 1;
+				buffersOffloaded++;
+			}
+		}
+
+		elapsed = get_cycle_count() - intervalStart;
+		if(elapsed >= SYS_CLK_FREQ)
+		{
+			saved_psr = HAL_disable_interrupts();
+			samples = adc_stream.samples;
+			dropped = adc_stream.dropped;
+			maxJitter = adc_stream.maxJitter;
+			jitterSum = adc_stream.jitterSum;
+			adc_stream.maxJitter = 0;
+			adc_stream.jitterSum = 0;
+			HAL_restore_interrupts(saved_psr);
+
+			uart_printf("\t%7u S/s jitter max %u mean %u cycles dropped %u (%u total) buffers %u\n\r",
+						(uint32_t)(((uint64_t)(samples - lastSamples) * SYS_CLK_FREQ) / elapsed),
+						maxJitter, (samples != lastSamples) ? jitterSum / (samples - lastSamples) : 0,
+						dropped - lastDropped, dropped, buffersOffloaded);
+
+			lastSamples = samples;
+			lastDropped = dropped;
+			intervalStart += elapsed;
+		}
+	}
+
+	TMR_stop(&adc_timer);
+	saved_psr = HAL_disable_interrupts();
+	PLIC_DisableIRQ(TIMER0_IRQn);
+	HAL_restore_interrupts(saved_psr);
+	TMR_clear_int(&adc_timer);
+
+	if(offload == ADC_OFFLOAD_UART)
+		UART_16550_tx_flush(&g_uart_16550);
+
+	uart_printf("\n\r\tTotal: %u samples, %u dropped, %u buffers offloaded\n\r", adc_stream.samples,
+				adc_stream.dropped, buffersOffloaded);
+}
+
+/**
+ * @brief	Offloads as much of a full buffer as can go without waiting
+ *
+ * @details	The Core16550 takes whatever fits in its transmit ring
+ * 			buffer. The FRAM takes one ADC_FRAM_CHUNK with interrupts
+ * 			disabled, as the sample interrupt would otherwise change
+ * 			the slave select in the middle of the write; the address
+ * 			wraps at the end of the FRAM. Ticks that come while the
+ * 			write holds interrupts off are counted as dropped by the
+ * 			interrupt handler.
+ *
+ * @param offload		Where the data goes
+ * @param data			Data left to offload
+ * @param length		Bytes left to offload
+ * @param framAddress	Next FRAM address, moved on by the bytes written
+ *
+ * @return	Bytes offloaded
+ */
+static uint32_t adc_offload(ADC_OFFLOAD offload, const uint8_t *data, uint32_t length, uint32_t *framAddress)
+{
+	uint32_t count = 0;
+	psr_t saved_psr;
+
+	if(offload == ADC_OFFLOAD_UART)
+		return UART_16550_queue_tx(&g_uart_16550, data, length);
+
+	count = (length > ADC_FRAM_CHUNK) ? ADC_FRAM_CHUNK : length;
+	if(*framAddress + count > g_fram.size)
+		*framAddress = 0;
+
+	saved_psr = HAL_disable_interrupts();
+	fram_write(&g_fram, *framAddress, data, count);
+	HAL_restore_interrupts(saved_psr);
+
+	*framAddress += count;
+	return count;
+}
+
+/**
+ * @brief	Interrupt handler for CoreTimer0, the sample clock. Takes
+ * 			one sample and measures the time since the last one.
+ * 
+ * @details	Ticks that come while interrupts are held off, as by the
+ * 			FRAM offload, run together into one interrupt. The interval
+ * 			shows how many were missed; they are counted as dropped and
+ * 			the jitter is measured against the whole number of periods.
+ *
+ * @details	The frame sent selects the next channel while the result
+ * 			of the previous frame comes back, so one 2 byte exchange
+ * 			is one sample. The result of the very first frame is not a
+ * 			conversion and is thrown away.
+ */
+uint8_t External_30_IRQHandler(void)
+{
+	uint8_t cmd[2];
+	uint8_t result[2];
+	uint32_t now = get_cycle_count();
+	uint32_t interval = 0;
+	uint32_t jitter = 0;
+	uint32_t periods = 0;
+	uint16_t sample = 0;
+
+	TMR_clear_int(&adc_timer);
+
+	if(adc_stream.primed)
+	{
+		interval = now - adc_stream.lastTick;
+		periods = (interval + adc_stream.expectedCycles / 2u) / adc_stream.expectedCycles;
+		if(periods > 1)
+		{
+			adc_stream.dropped += periods - 1u;
+			interval -= (periods - 1u) * adc_stream.expectedCycles;
+		}
+		jitter = (interval > adc_stream.expectedCycles) ? interval - adc_stream.expectedCycles
+														: adc_stream.expectedCycles - interval;
+		if(jitter > adc_stream.maxJitter)
+			adc_stream.maxJitter = jitter;
+		adc_stream.jitterSum += jitter;
+	}
+	adc_stream.lastTick = now;
+
+	cmd[0] = ADC_CHANNEL_CMD(adc_stream.nextChannel);
+	cmd[1] = 0;
+	SPI_set_slave_select(adc_dev.spi, adc_dev.spi_sel);
+	SPI_transfer_duplex(adc_dev.spi, cmd, result, sizeof(cmd));
+	SPI_clear_slave_select(adc_dev.spi, adc_dev.spi_sel);
+
+	if(adc_stream.primed)
+	{
+		sample = (uint16_t)((((uint16_t)result[0] << 8) | result[1]) & ADC_RESULT_MASK);
+		sample |= (uint16_t)(adc_stream.prevChannel << ADC_SAMPLE_CHANNEL_SHIFT);
+
+		if(adc_stream.full[adc_stream.fillBuffer])
+		{
+			adc_stream.dropped++;
+		}
+		else
+		{
+			adc_stream.buffers[adc_stream.fillBuffer][adc_stream.fillIdx++] = sample;
+			if(adc_stream.fillIdx == ADC_BUFFER_SAMPLES)
+			{
+				adc_stream.full[adc_stream.fillBuffer] = 1;
+				adc_stream.fillBuffer ^= 1;
+				adc_stream.fillIdx = 0;
+			}
+		}
+		adc_stream.samples++;
+	}
+	adc_stream.primed = 1;
+
+	adc_stream.prevChannel = adc_stream.nextChannel;
+	adc_stream.nextChannel = (uint8_t)((adc_stream.nextChannel + 1u) % adc_stream.channels);
+
+	return (EXT_IRQ_KEEP_ENABLED);
+}
@@ -0,0 +1,105 @@
+/**
+ * @file 	adc_test.h
+ * @author	Zac Carico
+ * @date 	Oct 16 2026
+ *
+ * @brief	Header file containing all the prototypes
+ * 			and declarations for the ADC test
+ *
+ * @details	CoreTimer0 interrupts at the sample rate and the interrupt
+ * 			handler reads adc_dev with a full-duplex exchange, sending
+ * 			the next channel while reading the previous conversion.
+ * 			Samples go into one of two buffers; when it is full the
+ * 			handler moves to the other one and the main loop offloads
+ * 			the full buffer to the Core16550 or the FRAM. A sample that
+ * 			finds both buffers full is dropped, and so is a tick that
+ * 			never got its interrupt because interrupts were held off
+ * 			for longer than a sample period.
+ *
+ * 			The ADC is assumed to be ADC128S102 compatible: a 16 bit
+ * 			frame with the next channel in bits 13-11 of what is sent,
+ * 			and the 12 bit result of the previous frame in what comes
+ * 			back.
+ */
+
+#ifndef ADC_TEST_H
+#define ADC_TEST_H
+
+#include <stdint.h>
+#include "hw_platform.h"
+#include "riscv_hal.h"
+#include "hal.h"
+#include "core_uart_apb.h"
+#include "core_16550.h"
+#include "core_timer.h"
+#include "core_spi.h"
+#include "spi_test_prog.h"
+#include "fram.h"
+#include "user_handler.h"
+#include "cycle_count.h"
+
+/** @brief Samples in each of the two buffers */
+#define ADC_BUFFER_SAMPLES		256u
+
+/** @brief Highest sample rate that can be entered, in Hz */
+#define ADC_MAX_RATE_HZ			50000u
+
+/** @brief Number of ADC input channels */
+#define ADC_NUM_CHANNELS		8u
+
+/** @brief First byte of the frame that selects the next channel */
+#define ADC_CHANNEL_CMD(ch)		((uint8_t)((ch) << 3))
+
+/** @brief Bits of a result */
+#define ADC_RESULT_MASK			0x0FFFu
+
+/** @brief Stored samples carry their channel above the result */
+#define ADC_SAMPLE_CHANNEL_SHIFT	12u
+
+/** @brief CoreTimer0 prescaler and the clock it leaves to count */
+#define ADC_TIMER_PRESCALE		PRESCALER_DIV_2
+#define ADC_TIMER_CLK_FREQ		(SYS_CLK_FREQ / 2u)
+
+/**
+ * @brief	Bytes written to the FRAM at a time. Sampling is held off
+ * 			while a chunk is written as the FRAM shares the CoreSPI.
+ */
+#define ADC_FRAM_CHUNK			32u
+
+/**
+ * @brief	Where full buffers are offloaded
+ */
+typedef enum {
+	ADC_OFFLOAD_UART,	/**< Raw little-endian samples on g_uart_16550 */
+	ADC_OFFLOAD_FRAM,	/**< Written round the FRAM from address 0 */
+	NUM_ADC_OFFLOAD
+} ADC_OFFLOAD;
+
+/**
+ * @brief	State shared between the CoreTimer0 interrupt and the
+ * 			main loop of "adc_test_stream()"
+ */
+typedef struct {
+	uint16_t buffers[2][ADC_BUFFER_SAMPLES];	/**< Double buffer */
+	volatile uint8_t full[2];		/**< Set by the handler, cleared once offloaded */
+	volatile uint8_t fillBuffer;	/**< Buffer being filled */
+	volatile uint16_t fillIdx;		/**< Next sample in fillBuffer */
+	uint8_t channels;				/**< Channels sampled in turn */
+	uint8_t nextChannel;			/**< Channel sent in the next frame */
+	uint8_t prevChannel;			/**< Channel of the result in the next frame */
+	uint8_t primed;					/**< Set once a channel has been sent */
+	uint32_t expectedCycles;		/**< Cycles between samples at the set rate */
+	uint32_t lastTick;				/**< Cycle count of the last interrupt */
+	volatile uint32_t samples;		/**< Samples taken */
+	volatile uint32_t dropped;		/**< Samples lost with both buffers full or ticks missed */
+	volatile uint32_t maxJitter;	/**< Largest error of a sample interval, in cycles */
+	volatile uint32_t jitterSum;	/**< Sum of the errors, for the mean */
+} adc_stream_t;
+
+extern UART_instance_t g_uart;
+extern uart_16550_instance_t g_uart_16550;
+
+void adc_test_handler(void);
+void adc_test_stream(uint32_t rateHz, uint8_t channels, ADC_OFFLOAD offload);
+
+#endif /*ADC_TEST_H*/
@@ -0,0 +1,700 @@
+/**
+ * @file 	cmd_protocol.c
+ * @author	Zac Carico
+ * @date 	Oct 16 2026
+ * 
+ * @brief	Function definitions of cmd_protocol.h
+ */
+
+#include "cmd_protocol.h"
+#include "hal.h"
+#include "core_gpio.h"
+#include "spi_test_prog.h"
+#include "i2c_test_routine.h"
+#include "cycle_count.h"
+#include "prbs.h"
+
+/** @brief Number of bytes in front of the data of a response: seq, cmd and status */
+#define RESPONSE_HEADER_SIZE	3u
+
+/** @brief Number of bytes in front of the parameters of a request: seq and cmd */
+#define REQUEST_HEADER_SIZE		2u
+
+/** @brief Size of the CRC at the end of every message */
+#define CRC_SIZE				2u
+
+/** @brief Cycles taken to send one character at a CoreUARTapb baud value */
+#define BAUD_CHAR_CYCLES(value)	(160u * ((uint32_t)(value) + 1u))
+
+/**
+ * @brief	Frames being received by "cmd_protocol_rx_handler()". One 
+ * 			buffer is filled by the interrupt while the other waits to be 
+ * 			handled by "cmd_protocol_service()".
+ */
+static uint8_t rx_frames[2][CMD_MAX_FRAME];
+static volatile uint16_t rx_frame_length[2];
+static volatile uint8_t rx_frame_idx;
+static volatile uint8_t rx_in_frame;
+static uint32_t rx_last_cycles;
+static volatile uint8_t ready_frame_idx;
+static volatile uint8_t frame_ready;
+
+/** @brief Decoded request, then response message */
+static uint8_t message[CMD_MAX_MESSAGE];
+
+/** @brief Encoded response, including both delimiters */
+static uint8_t tx_frame[CMD_MAX_FRAME + 2u];
+
+/** @brief Frame counters returned by CMD_GET_STATS */
+static uint32_t frames_ok;
+static uint32_t frames_bad;
+static volatile uint32_t frames_dropped;
+
+/** @brief Baud value g_uart runs at, and the one proposed by CMD_SET_BAUD */
+static uint16_t baud_value;
+static uint16_t proposed_baud_value;
+
+/** @brief Bad frames received at a negotiated baud rate since the last good frame */
+static uint8_t baud_errors;
+
+/**
+ * @brief	Set while a new baud rate waits for CMD_BAUD_CONFIRM, with the 
+ * 			baud value to go back to and the cycle count it was switched at
+ */
+static uint8_t baud_confirming;
+static uint16_t baud_old_value;
+static uint32_t baud_switch_start;
+
+/** @brief SPI devices in SPI_DEVICE_ID order */
+static spi_dev * const spi_devices[] = {
+	&fram_dev,
+	&external_spi_0,
+	&external_spi_1,
+	&adc_dev,
+	&lcd_screen_dev,
+	&accelerometer_dev
+};
+
+#define NUM_SPI_DEVICES	(sizeof(spi_devices) / sizeof(spi_devices[0]))
+
+/** @brief CRC-16/CCITT remainders of each nibble value */
+static const uint16_t crc16_nibble_table[16] = {
+	0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+	0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+extern gpio_instance_t g_gpio_out;
+
+static void send_response(uint8_t seq, uint8_t cmd, uint8_t status, uint16_t dataLength);
+static uint8_t run_command(uint8_t cmd, const uint8_t *params, uint16_t paramLength,
+						   uint8_t *data, uint16_t *dataLength);
+static uint8_t i2c_status_to_cmd_status(i2c_status_t status);
+static uint8_t baud_propose(uint32_t baud, uint8_t *data, uint16_t *dataLength);
+static void baud_switch(void);
+static void baud_service_confirm(void);
+static uint8_t baud_check_confirm(uint8_t *seq);
+static void baud_count_error(void);
+static void baud_wait_tx_idle(void);
+
+/**
+ * @brief	Sets up the SPI and I2C used by the commands and starts 
+ * 			watching the console for frames. Call once after g_uart 
+ * 			has its receive ring buffer.
+ */
+void cmd_protocol_init(void)
+{
+	spi_test_init();
+	i2c_test_init();
+	baud_value = BAUD_VALUE_115200;
+	UART_set_rx_handler(&g_uart, cmd_protocol_rx_handler);
+}
+
+/**
+ * @brief	Receive character handler registered with g_uart. Collects 
+ * 			the characters between two delimiters into a frame.
+ * 
+ * @details	Called from the UART receive interrupt. Characters outside a 
+ * 			frame are left to the console. A frame that arrives while the 
+ * 			previous one is still waiting is dropped. So that a stray 
+ * 			delimiter (line noise, a break) can't keep the console from 
+ * 			getting its characters, a frame that grows past CMD_MAX_FRAME 
+ * 			or stops for CMD_FRAME_TIMEOUT_CYCLES is dropped as well and 
+ * 			the characters after it go to the console again.
+ * 
+ * @param this_uart	UART the character was received on
+ * @param rx_char	Received character
+ * 
+ * @return	1 : The character belongs to a frame
+ * 			0 : The character is console input
+ */
+uint8_t cmd_protocol_rx_handler(UART_instance_t *this_uart, uint8_t rx_char)
+{
+	uint8_t idx = rx_frame_idx;
+	uint32_t now = get_cycle_count();
+
+	(void)this_uart;
+
+	if(rx_in_frame && now - rx_last_cycles > CMD_FRAME_TIMEOUT_CYCLES)
+	{
+		frames_dropped++;
+		rx_in_frame = 0;
+	}
+	rx_last_cycles = now;
+
+	if(rx_in_frame == 0)
+	{
+		if(rx_char != CMD_FRAME_DELIMITER)
+			return 0;
+
+		rx_in_frame = 1;
+		rx_frame_length[idx] = 0;
+	}
+	else if(rx_char == CMD_FRAME_DELIMITER)
+	{
+		// Back to back delimiters are skipped, an empty frame means nothing
+		if(rx_frame_length[idx] > 0)
+		{
+			if(frame_ready)
+			{
+				frames_dropped++;
+			}
+			else
+			{
+				ready_frame_idx = idx;
+				frame_ready = 1;
+				rx_frame_idx = idx ^ 1;
+			}
+			rx_in_frame = 0;
+		}
+	}
+	else if(rx_frame_length[idx] < CMD_MAX_FRAME)
+	{
+		rx_frames[idx][rx_frame_length[idx]] = rx_char;
+		rx_frame_length[idx]++;
+	}
+	else
+	{
+		// Too long to be a frame, most likely a stray delimiter
+		frames_dropped++;
+		rx_in_frame = 0;
+	}
+
+	return 1;
+}
+
+/**
+ * @brief	Handles a received frame, if there is one. Called from the 
+ * 			loops that wait for console input so that frames are handled 
+ * 			whichever menu is waiting.
+ */
+void cmd_protocol_service(void)
+{
+	uint16_t length = 0;
+	uint16_t dataLength = 0;
+	uint8_t status = CMD_OK;
+	uint8_t seq = 0;
+	uint8_t cmd = 0;
+
+	if(baud_confirming)
+	{
+		baud_service_confirm();
+		return;
+	}
+
+	if(frame_ready == 0)
+		return;
+
+	length = cobs_decode(rx_frames[ready_frame_idx], rx_frame_length[ready_frame_idx],
+						 message, sizeof(message));
+	frame_ready = 0;
+
+	if(length < REQUEST_HEADER_SIZE + CRC_SIZE)
+	{
+		frames_bad++;
+		baud_count_error();
+		return;
+	}
+
+	seq = message[0];
+	cmd = message[1];
+	if(seq > CMD_SEQ_MAX)
+	{
+		// Can't be echoed without looking like a log record
+		frames_bad++;
+		return;
+	}
+
+	length -= CRC_SIZE;
+	if(crc16_ccitt(message, length) !=
+	   (uint16_t)(message[length] | (message[length + 1] << 8)))
+	{
+		frames_bad++;
+		baud_count_error();
+		send_response(seq, cmd, CMD_ERR_CRC, 0);
+		return;
+	}
+
+	frames_ok++;
+	baud_errors = 0;
+
+	status = run_command(cmd, &message[REQUEST_HEADER_SIZE], length - REQUEST_HEADER_SIZE,
+						 &message[RESPONSE_HEADER_SIZE], &dataLength);
+	send_response(seq, cmd, status, dataLength);
+
+	if(cmd == CMD_SET_BAUD && status == CMD_OK)
+		baud_switch();
+}
+
+/**
+ * @brief	Runs one command
+ * 
+ * @details	"params" and "data" point into the same message buffer, 
+ * 			"data" one byte further on. Commands read every parameter 
+ * 			they need before writing any data.
+ * 
+ * @param cmd			Command to run
+ * @param params		Parameters of the command
+ * @param paramLength	Number of parameter bytes
+ * @param data			Filled with the response data
+ * @param dataLength	Set to the number of response data bytes
+ * 
+ * @return	CMD_STATUS of the command
+ */
+static uint8_t run_command(uint8_t cmd, const uint8_t *params, uint16_t paramLength,
+						   uint8_t *data, uint16_t *dataLength)
+{
+	uint8_t arg[3];
+	uint16_t i = 0;
+	spi_dev *device;
+
+	*dataLength = 0;
+
+	switch(cmd)
+	{
+		case CMD_PING:
+			if(paramLength > CMD_MAX_DATA)
+				return CMD_ERR_LENGTH;
+			// Copy from the end as the data overlaps the parameters
+			for(i = paramLength; i > 0; i--)
+				data[i - 1] = params[i - 1];
+			*dataLength = paramLength;
+			return CMD_OK;
+
+		case CMD_SPI_TRANSFER:
+			if(paramLength < 3 || paramLength != 3u + params[1] ||
+			   params[1] + params[2] > CMD_MAX_DATA)
+				return CMD_ERR_LENGTH;
+			if(params[0] >= NUM_SPI_DEVICES)
+				return CMD_ERR_PARAM;
+			device = spi_devices[params[0]];
+			arg[2] = params[2];
+			// The command bytes are moved to the end of the buffer so 
+			// the received bytes can't overwrite them. The length check 
+			// above keeps the two apart.
+			for(i = params[1]; i > 0; i--)
+				message[CMD_MAX_MESSAGE - params[1] + i - 1] = params[3 + i - 1];
+			SPI_set_slave_select(device->spi, device->spi_sel);
+			SPI_transfer_block(device->spi, &message[CMD_MAX_MESSAGE - params[1]], params[1],
+							   data, arg[2]);
+			SPI_clear_slave_select(device->spi, device->spi_sel);
+			*dataLength = arg[2];
+			return CMD_OK;
+
+		case CMD_I2C_WRITE:
+			if(paramLength < 2 || paramLength != 2u + params[1])
+				return CMD_ERR_LENGTH;
+			return i2c_status_to_cmd_status(
+					do_write_transaction(params[0], (uint8_t *)&params[2], params[1]));
+
+		case CMD_I2C_READ:
+			if(paramLength != 2)
+				return CMD_ERR_LENGTH;
+			arg[0] = params[0];
+			arg[1] = params[1];
+			*dataLength = arg[1];
+			return i2c_status_to_cmd_status(do_read_transaction(arg[0], data, arg[1]));
+
+		case CMD_I2C_WRITE_READ:
+			if(paramLength < 3 || paramLength != 3u + params[1] ||
+			   params[1] + params[2] > CMD_MAX_DATA)
+				return CMD_ERR_LENGTH;
+			arg[0] = params[0];
+			arg[1] = params[1];
+			arg[2] = params[2];
+			// Same as CMD_SPI_TRANSFER, keep the write data out of the way
+			for(i = arg[1]; i > 0; i--)
+				message[CMD_MAX_MESSAGE - arg[1] + i - 1] = params[3 + i - 1];
+			*dataLength = arg[2];
+			return i2c_status_to_cmd_status(
+					do_write_read_transaction(arg[0], &message[CMD_MAX_MESSAGE - arg[1]], arg[1],
+											  data, arg[2]));
+
+		case CMD_GPIO_SET:
+			if(paramLength != 2)
+				return CMD_ERR_LENGTH;
+			if(params[0] > GPIO_31)
+				return CMD_ERR_PARAM;
+			GPIO_set_output(&g_gpio_out, (gpio_id_t)params[0], params[1]);
+			return CMD_OK;
+
+		case CMD_GET_STATS:
+			for(i = 0; i < 4; i++)
+			{
+				data[i] = (uint8_t)(frames_ok >> (8 * i));
+				data[4 + i] = (uint8_t)(frames_bad >> (8 * i));
+				data[8 + i] = (uint8_t)(frames_dropped >> (8 * i));
+			}
+			*dataLength = 12;
+			return CMD_OK;
+
+		case CMD_SET_BAUD:
+			if(paramLength != 4)
+				return CMD_ERR_LENGTH;
+			return baud_propose((uint32_t)params[0] | ((uint32_t)params[1] << 8) |
+								((uint32_t)params[2] << 16) | ((uint32_t)params[3] << 24),
+								data, dataLength);
+
+		case CMD_BAUD_CONFIRM:
+			// Only accepted by "baud_service_confirm()" straight after CMD_SET_BAUD
+			return CMD_ERR_PARAM;
+
+		default:
+			return CMD_ERR_UNKNOWN;
+	}
+}
+
+/**
+ * @brief	Converts the result of an I2C transaction into a CMD_STATUS
+ * 
+ * @param status	Result returned by the I2C transaction
+ * 
+ * @return	CMD_STATUS equivalent of status
+ */
+static uint8_t i2c_status_to_cmd_status(i2c_status_t status)
+{
+	switch(status)
+	{
+		case I2C_SUCCESS:
+			return CMD_OK;
+		case I2C_TIMED_OUT:
+			return CMD_ERR_I2C_TIMED_OUT;
+		default:
+			return CMD_ERR_I2C_FAILED;
+	}
+}
+
+/**
+ * @brief	Works out the CoreUARTapb baud value nearest to a baud rate 
+ * 			and keeps it for "baud_switch()" if it is close enough
+ * 
+ * @param baud			Proposed baud rate
+ * @param data			Filled with the baud value, the actual baud rate 
+ * 						and its error in hundredths of a percent
+ * @param dataLength	Set to the number of response data bytes
+ * 
+ * @return	CMD_OK if the link can switch, CMD_ERR_PARAM if the baud value 
+ * 			doesn't fit in MAX_BAUD_VALUE or the error is over BAUD_MAX_ERROR
+ */
+static uint8_t baud_propose(uint32_t baud, uint8_t *data, uint16_t *dataLength)
+{
+	uint32_t divisor = 0;
+	uint32_t actual = 0;
+	int32_t error = 0;
+
+	if(baud == 0 || baud > SYS_CLK_FREQ / 16u)
+		return CMD_ERR_PARAM;
+
+	// Nearest divisor rather than the truncated one of BAUD_VALUE_115200
+	divisor = (SYS_CLK_FREQ + baud * 8u) / (baud * 16u);
+	if(divisor - 1u > MAX_BAUD_VALUE)
+		return CMD_ERR_PARAM;
+
+	actual = SYS_CLK_FREQ / (divisor * 16u);
+	error = (int32_t)((((int64_t)actual - (int64_t)baud) * 10000) / (int64_t)baud);
+
+	data[0] = (uint8_t)(divisor - 1u);
+	data[1] = (uint8_t)((divisor - 1u) >> 8);
+	data[2] = (uint8_t)actual;
+	data[3] = (uint8_t)(actual >> 8);
+	data[4] = (uint8_t)(actual >> 16);
+	data[5] = (uint8_t)(actual >> 24);
+	data[6] = (uint8_t)error;
+	data[7] = (uint8_t)((uint32_t)error >> 8);
+	*dataLength = 8;
+
+	if(error > BAUD_MAX_ERROR || error < -BAUD_MAX_ERROR)
+		return CMD_ERR_PARAM;
+
+	proposed_baud_value = (uint16_t)(divisor - 1u);
+	return CMD_OK;
+}
+
+/**
+ * @brief	Switches g_uart to the baud value accepted by CMD_SET_BAUD 
+ * 			and starts waiting for the rig to confirm it
+ * 
+ * @details	Doesn't wait for the confirmation, "cmd_protocol_service()" 
+ * 			checks for it on later polls. Frames are still collected by 
+ * 			"cmd_protocol_rx_handler()" at the new rate.
+ */
+static void baud_switch(void)
+{
+	// The CMD_SET_BAUD response has to finish at the old rate
+	baud_wait_tx_idle();
+	baud_old_value = baud_value;
+	UART_set_baud_value(&g_uart, proposed_baud_value);
+
+	// Receive errors are only looked at during the confirmation
+	(void)UART_get_rx_status(&g_uart);
+	frame_ready = 0;
+
+	baud_switch_start = get_cycle_count();
+	baud_confirming = 1;
+}
+
+/**
+ * @brief	Polled while a new baud rate is being confirmed. Keeps the 
+ * 			new rate once a good CMD_BAUD_CONFIRM arrives and goes back 
+ * 			to the old one on anything else, or after BAUD_CONFIRM_CYCLES.
+ */
+static void baud_service_confirm(void)
+{
+	uint8_t seq = 0;
+
+	if(frame_ready == 0 && get_cycle_count() - baud_switch_start < BAUD_CONFIRM_CYCLES)
+		return;
+
+	baud_confirming = 0;
+
+	if(frame_ready && baud_check_confirm(&seq) &&
+	   (UART_get_rx_status(&g_uart) & (UART_APB_FRAMING_ERROR | UART_APB_PARITY_ERROR)) == 0)
+	{
+		baud_value = proposed_baud_value;
+		baud_errors = 0;
+		frames_ok++;
+		send_response(seq, CMD_BAUD_CONFIRM, CMD_OK, BAUD_PATTERN_LENGTH);
+	}
+	else
+	{
+		UART_set_baud_value(&g_uart, baud_old_value);
+		(void)UART_get_rx_status(&g_uart);
+	}
+	frame_ready = 0;
+}
+
+/**
+ * @brief	Checks that the waiting frame is a CMD_BAUD_CONFIRM request 
+ * 			carrying the PRBS-15 test pattern, and leaves the pattern in 
+ * 			"message" as the response data
+ * 
+ * @param seq	Set to the sequence number of the request
+ * 
+ * @return	1 : The pattern was received correctly
+ * 			0 : Anything else was received
+ */
+static uint8_t baud_check_confirm(uint8_t *seq)
+{
+	uint16_t length = 0;
+	prbs_gen_t gen;
+	uint16_t i = 0;
+
+	length = cobs_decode(rx_frames[ready_frame_idx], rx_frame_length[ready_frame_idx],
+						 message, sizeof(message));
+	if(length != REQUEST_HEADER_SIZE + BAUD_PATTERN_LENGTH + CRC_SIZE ||
+	   message[0] > CMD_SEQ_MAX || message[1] != CMD_BAUD_CONFIRM)
+		return 0;
+
+	length -= CRC_SIZE;
+	if(crc16_ccitt(message, length) !=
+	   (uint16_t)(message[length] | (message[length + 1] << 8)))
+		return 0;
+
+	prbs_init(&gen, PRBS_15);
+	for(i = 0; i < BAUD_PATTERN_LENGTH; i++)
+	{
+		if(message[REQUEST_HEADER_SIZE + i] != prbs_next_byte(&gen))
+			return 0;
+	}
+
+	// Move the pattern to where the response data goes
+	for(i = BAUD_PATTERN_LENGTH; i > 0; i--)
+		message[RESPONSE_HEADER_SIZE + i - 1] = message[REQUEST_HEADER_SIZE + i - 1];
+
+	*seq = message[0];
+	return 1;
+}
+
+/**
+ * @brief	Counts a bad frame while the link runs at a negotiated baud 
+ * 			rate and falls back to 115200 after BAUD_FALLBACK_ERRORS of 
+ * 			them
+ * 
+ * @details	Bad frames are counted rather than the UART's framing and 
+ * 			parity errors, as reading those clears them for everything 
+ * 			else that uses g_uart.
+ */
+static void baud_count_error(void)
+{
+	if(baud_value == BAUD_VALUE_115200)
+		return;
+
+	baud_errors++;
+	if(baud_errors >= BAUD_FALLBACK_ERRORS)
+	{
+		baud_wait_tx_idle();
+		UART_set_baud_value(&g_uart, BAUD_VALUE_115200);
+		baud_value = BAUD_VALUE_115200;
+		baud_errors = 0;
+	}
+}
+
+/**
+ * @brief	Waits until everything queued on g_uart has been sent at the 
+ * 			current baud rate. TXRDY is set while the last character is 
+ * 			still being shifted out, so two character times are added.
+ */
+static void baud_wait_tx_idle(void)
+{
+	uint32_t start = 0;
+
+	UART_tx_flush(&g_uart);
+	start = get_cycle_count();
+	while(get_cycle_count() - start < 2u * BAUD_CHAR_CYCLES(baud_value))
+		;
+}
+
+/**
+ * @brief	Finishes the response held in "message", then encodes and 
+ * 			queues it
+ * 
+ * @param seq			Sequence number of the request
+ * @param cmd			Command of the request
+ * @param status		CMD_STATUS of the command
+ * @param dataLength	Number of data bytes already in the message
+ */
+static void send_response(uint8_t seq, uint8_t cmd, uint8_t status, uint16_t dataLength)
+{
+	uint16_t length = RESPONSE_HEADER_SIZE + dataLength;
+	uint16_t crc = 0;
+	uint16_t frameLength = 0;
+
+	message[0] = seq;
+	message[1] = cmd | CMD_RESPONSE_FLAG;
+	message[2] = status;
+	crc = crc16_ccitt(message, length);
+	message[length] = (uint8_t)crc;
+	message[length + 1] = (uint8_t)(crc >> 8);
+	length += CRC_SIZE;
+
+	tx_frame[0] = CMD_FRAME_DELIMITER;
+	frameLength = cobs_encode(message, length, &tx_frame[1]) + 1;
+	tx_frame[frameLength] = CMD_FRAME_DELIMITER;
+	frameLength++;
+
+	UART_send(&g_uart, tx_frame, frameLength);
+}
+
+/**
+ * @brief	COBS encodes a message so it contains no 0x00 bytes
+ * 
+ * @param src		Message to encode
+ * @param length	Number of bytes in the message
+ * @param dst		Filled with the encoded message. Must hold 
+ * 					length + length / 254 + 1 bytes
+ * 
+ * @return	Number of bytes in the encoded message
+ */
+uint16_t cobs_encode(const uint8_t *src, uint16_t length, uint8_t *dst)
+{
+	uint16_t readIdx = 0;
+	uint16_t writeIdx = 1;
+	uint16_t codeIdx = 0;
+	uint8_t code = 1;
+
+	while(readIdx < length)
+	{
+		if(src[readIdx] == 0)
+		{
+			dst[codeIdx] = code;
+			codeIdx = writeIdx++;
+			code = 1;
+		}
+		else
+		{
+			dst[writeIdx++] = src[readIdx];
+			code++;
+			if(code == 0xFF)
+			{
+				dst[codeIdx] = code;
+				codeIdx = writeIdx++;
+				code = 1;
+			}
+		}
+		readIdx++;
+	}
+	dst[codeIdx] = code;
+
+	return writeIdx;
+}
+
+/**
+ * @brief	Decodes a COBS encoded message
+ * 
+ * @param src		Encoded message, without delimiters
+ * @param length	Number of bytes in the encoded message
+ * @param dst		Filled with the decoded message
+ * @param dstSize	Size of the dst array
+ * 
+ * @return	Number of bytes in the decoded message, 0 if the encoding 
+ * 			is invalid or the message doesn't fit in dst
+ */
+uint16_t cobs_decode(const uint8_t *src, uint16_t length, uint8_t *dst, uint16_t dstSize)
+{
+	uint16_t readIdx = 0;
+	uint16_t writeIdx = 0;
+	uint8_t code = 0;
+	uint8_t i = 0;
+
+	while(readIdx < length)
+	{
+		code = src[readIdx++];
+		if(code == 0 || readIdx + code - 1 > length || writeIdx + code - 1 > dstSize)
+			return 0;
+
+		for(i = 1; i < code; i++)
+			dst[writeIdx++] = src[readIdx++];
+
+		// A code below 0xFF stands for a zero, except at the end
+		if(code != 0xFF && readIdx < length)
+		{
+			if(writeIdx >= dstSize)
+				return 0;
+			dst[writeIdx++] = 0;
+		}
+	}
+
+	return writeIdx;
+}
+
+/**
+ * @brief	Calculates the CRC-16/CCITT-FALSE of a buffer, a nibble at 
+ * 			a time to keep the table small
+ * 
+ * @param data		Buffer to calculate the CRC of
+ * @param length	Number of bytes in the buffer
+ * 
+ * @return	CRC of the buffer
+ */
+uint16_t crc16_ccitt(const uint8_t *data, uint16_t length)
+{
+	uint16_t crc = 0xFFFF;
+	uint16_t i = 0;
+
+	for(i = 0; i < length; i++)
+	{
+		crc = (crc << 4) ^ crc16_nibble_table[(crc >> 12) ^ (data[i] >> 4)];
+		crc = (crc << 4) ^ crc16_nibble_table[(crc >> 12) ^ (data[i] & 0x0F)];
+	}
+
+	return crc;
+}
@@ -0,0 +1,149 @@
+/**
+ * @file 	cmd_protocol.h
+ * @author	Zac Carico
+ * @date 	Oct 16 2026
+ * 
+ * @brief	Header file containing all the prototypes and declarations 
+ * 			for the binary command protocol
+ * 
+ * @details	The binary command protocol lets an automated test rig call 
+ * 			the test primitives directly, one frame per transaction, while 
+ * 			the keystroke menus stay available to a person on the same 
+ * 			console. 
+ * 
+ * 			Every frame is sent as a 0x00 delimiter, the COBS encoded 
+ * 			message, then another 0x00 delimiter. COBS removes every 0x00 
+ * 			from the message, and a person never types 0x00, so the 
+ * 			receive interrupt can tell frames from keystrokes. 
+ * 
+ * 			Messages (before COBS encoding, multi-byte values little endian):
+ * 			- Request:	[seq][cmd][params ...][crc16]
+ * 			- Response:	[seq][cmd | 0x80][status][data ...][crc16]
+ * 
+ * 			"seq" is chosen by the rig, at most CMD_SEQ_MAX, and copied 
+ * 			into the response. A request with a larger "seq" is dropped. The 
+ * 			CRC is CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) over every 
+ * 			byte before it. A request with a bad CRC is answered with 
+ * 			CMD_ERR_CRC, and a frame that can't be decoded is dropped.
+ * 
+ * 			Parameters and response data of each command:
+ * 			- CMD_PING:				[data ...]						-> [data ...]
+ * 			- CMD_SPI_TRANSFER:		[dev][cmd_len][rx_len][cmd ...]	-> [rx ...]
+ * 			- CMD_I2C_WRITE:		[addr][len][data ...]			-> none
+ * 			- CMD_I2C_READ:			[addr][len]						-> [data ...]
+ * 			- CMD_I2C_WRITE_READ:	[addr][wr_len][rd_len][data ...]-> [data ...]
+ * 			- CMD_GPIO_SET:			[gpio][value]					-> none
+ * 			- CMD_GET_STATS:		none							-> [ok u32][bad u32][dropped u32]
+ * 			- CMD_SET_BAUD:			[baud u32]						-> [baud_value u16][actual u32][error i16]
+ * 			- CMD_BAUD_CONFIRM:		[pattern ...]					-> [pattern ...]
+ * 
+ * 			"dev" is a SPI_DEVICE_ID and "addr" a 7-bit I2C address. 
+ * 			For CMD_SPI_TRANSFER and CMD_I2C_WRITE_READ the write and 
+ * 			read lengths together can't exceed CMD_MAX_DATA. CMD_GET_STATS counts 
+ * 			frames handled, frames with a bad CRC or encoding, and frames 
+ * 			dropped because they arrived too long, too early or stalled 
+ * 			for CMD_FRAME_TIMEOUT_CYCLES between two characters.
+ * 
+ * 			CMD_SET_BAUD proposes a new console baud rate. The response 
+ * 			gives the CoreUARTapb baud value, the rate it really produces 
+ * 			and its error in hundredths of a percent, and is sent at the 
+ * 			old rate. A rate that can't be made within BAUD_MAX_ERROR is 
+ * 			answered with CMD_ERR_PARAM. After a CMD_OK both ends switch, 
+ * 			and the rig has BAUD_CONFIRM_CYCLES to send CMD_BAUD_CONFIRM 
+ * 			with the first BAUD_PATTERN_LENGTH bytes of PRBS-15 at the new 
+ * 			rate. Anything else, or a receive error, puts the link back to 
+ * 			the old rate without a response. CMD_BAUD_CONFIRM is not 
+ * 			accepted at any other time, and no other frame is handled 
+ * 			while it is waited for. 
+ * 
+ * 			While the link runs faster than BAUD_VALUE_115200, 
+ * 			BAUD_FALLBACK_ERRORS frames with a bad CRC or encoding without 
+ * 			a good frame in between put it back to 115200. A rig can force 
+ * 			this by sending frames with a bad CRC.
+ */
+
+#ifndef CMD_PROTOCOL_H
+#define CMD_PROTOCOL_H
+
+#include <stdint.h>
+#include "core_uart_apb.h"
+#include "hw_platform.h"
+
+/** @brief Byte that starts and ends every frame */
+#define CMD_FRAME_DELIMITER	0x00u
+
+/** @brief Largest amount of data carried by one request or response */
+#define CMD_MAX_DATA		255u
+
+/** @brief Largest request or response message: seq, cmd, status/params, data and CRC */
+#define CMD_MAX_MESSAGE		(2u + 3u + CMD_MAX_DATA + 2u)
+
+/** @brief Largest COBS encoded message, one code byte per 254 bytes of message */
+#define CMD_MAX_FRAME		(CMD_MAX_MESSAGE + (CMD_MAX_MESSAGE / 254u) + 1u)
+
+/**
+ * @brief	Longest gap between two characters of a frame, 10 ms. A 
+ * 			frame that stalls for longer is dropped and the console gets 
+ * 			its characters back.
+ */
+#define CMD_FRAME_TIMEOUT_CYCLES	(SYS_CLK_FREQ / 100u)
+
+/**
+ * @brief	Largest sequence number of a request. 0xFE starts a log 
+ * 			record (TLOG_FRAME_TAG), so no response may start with it.
+ */
+#define CMD_SEQ_MAX			0xFDu
+
+/** @brief Set in the cmd byte of every response */
+#define CMD_RESPONSE_FLAG	0x80u
+
+/** @brief Largest baud rate error CMD_SET_BAUD accepts, in hundredths of a percent */
+#define BAUD_MAX_ERROR			200
+
+/** @brief Time the rig has to confirm a new baud rate, 1 s */
+#define BAUD_CONFIRM_CYCLES		SYS_CLK_FREQ
+
+/** @brief Number of PRBS-15 bytes carried by CMD_BAUD_CONFIRM */
+#define BAUD_PATTERN_LENGTH		64u
+
+/** @brief Receive errors at a negotiated baud rate before falling back to 115200 */
+#define BAUD_FALLBACK_ERRORS	4u
+
+/**
+ * @brief	Commands a rig can send
+ */
+typedef enum {
+	CMD_PING,
+	CMD_SPI_TRANSFER,
+	CMD_I2C_WRITE,
+	CMD_I2C_READ,
+	CMD_I2C_WRITE_READ,
+	CMD_GPIO_SET,
+	CMD_GET_STATS,
+	CMD_SET_BAUD,
+	CMD_BAUD_CONFIRM
+} CMD_ID;
+
+/**
+ * @brief	Status byte returned in every response
+ */
+typedef enum {
+	CMD_OK,
+	CMD_ERR_CRC,
+	CMD_ERR_LENGTH,
+	CMD_ERR_UNKNOWN,
+	CMD_ERR_PARAM,
+	CMD_ERR_I2C_FAILED,
+	CMD_ERR_I2C_TIMED_OUT
+} CMD_STATUS;
+
+extern UART_instance_t g_uart;
+
+void cmd_protocol_init(void);
+void cmd_protocol_service(void);
+uint8_t cmd_protocol_rx_handler(UART_instance_t *this_uart, uint8_t rx_char);
+uint16_t cobs_encode(const uint8_t *src, uint16_t length, uint8_t *dst);
+uint16_t cobs_decode(const uint8_t *src, uint16_t length, uint8_t *dst, uint16_t dstSize);
+uint16_t crc16_ccitt(const uint8_t *data, uint16_t length);
+
+#endif /*CMD_PROTOCOL_H*/
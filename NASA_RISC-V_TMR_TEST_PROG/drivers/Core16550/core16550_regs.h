@@ -0,0 +1,214 @@
+/**
+ * @file 	core16550_regs.h
+ * @author	Zac Carico
+ * @date 	Oct 16 2026
+ *
+ * @brief	Core16550 register offsets and bit definitions. Registers are 
+ * 			8 bits wide on a 32-bit APB stride.
+ */
+
+#ifndef __CORE_16550_REGISTERS_H
+#define __CORE_16550_REGISTERS_H    1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*------------------------------------------------------------------------------
+ * RBR: Receiver Buffer Register (read, DLAB = 0)
+ * THR: Transmitter Holding Register (write, DLAB = 0)
+ * DLR: Divisor Latch, least significant byte (DLAB = 1)
+ */
+#define RBR_REG_OFFSET      0x00u
+#define THR_REG_OFFSET      0x00u
+#define DLR_REG_OFFSET      0x00u
+
+/*------------------------------------------------------------------------------
+ * IER: Interrupt Enable Register (DLAB = 0)
+ * DMR: Divisor Latch, most significant byte (DLAB = 1)
+ */
+#define IER_REG_OFFSET      0x04u
+#define DMR_REG_OFFSET      0x04u
+
+/*
+ * Received data available and character timeout interrupt enable.
+ */
+#define IER_ERBFI_OFFSET    0x04u
+#define IER_ERBFI_MASK      0x01u
+#define IER_ERBFI_SHIFT     0u
+
+/*
+ * Transmitter holding register empty interrupt enable.
+ */
+#define IER_ETBEI_OFFSET    0x04u
+#define IER_ETBEI_MASK      0x02u
+#define IER_ETBEI_SHIFT     1u
+
+/*
+ * Receiver line status interrupt enable.
+ */
+#define IER_ELSI_OFFSET     0x04u
+#define IER_ELSI_MASK       0x04u
+#define IER_ELSI_SHIFT      2u
+
+/*
+ * Modem status interrupt enable.
+ */
+#define IER_EDSSI_OFFSET    0x04u
+#define IER_EDSSI_MASK      0x08u
+#define IER_EDSSI_SHIFT     3u
+
+/*------------------------------------------------------------------------------
+ * IIR: Interrupt Identification Register (read)
+ * FCR: FIFO Control Register (write)
+ */
+#define IIR_REG_OFFSET      0x08u
+#define FCR_REG_OFFSET      0x08u
+
+/*
+ * Interrupt identification, highest priority pending interrupt.
+ */
+#define IIR_IID_OFFSET      0x08u
+#define IIR_IID_MASK        0x0Fu
+#define IIR_IID_SHIFT       0u
+
+#define IIR_IID_MODEM_STATUS    0x00u
+#define IIR_IID_NONE            0x01u
+#define IIR_IID_THR_EMPTY       0x02u
+#define IIR_IID_RX_DATA         0x04u
+#define IIR_IID_RX_LINE_STATUS  0x06u
+#define IIR_IID_RX_TIMEOUT      0x0Cu
+
+/*
+ * Clear receiver FIFO, self clearing.
+ */
+#define FCR_CLEAR_RX_OFFSET 0x08u
+#define FCR_CLEAR_RX_MASK   0x02u
+#define FCR_CLEAR_RX_SHIFT  1u
+
+/*
+ * Clear transmitter FIFO, self clearing.
+ */
+#define FCR_CLEAR_TX_OFFSET 0x08u
+#define FCR_CLEAR_TX_MASK   0x04u
+#define FCR_CLEAR_TX_SHIFT  2u
+
+/*
+ * Receiver FIFO trigger level.
+ */
+#define FCR_TRIG_LEVEL_OFFSET   0x08u
+#define FCR_TRIG_LEVEL_MASK     0xC0u
+#define FCR_TRIG_LEVEL_SHIFT    6u
+
+/*------------------------------------------------------------------------------
+ * LCR: Line Control Register
+ */
+#define LCR_REG_OFFSET      0x0Cu
+
+/*
+ * Word length, stop bits and parity.
+ */
+#define LCR_WLS_OFFSET      0x0Cu
+#define LCR_WLS_MASK        0x03u
+#define LCR_WLS_SHIFT       0u
+
+#define LCR_STB_OFFSET      0x0Cu
+#define LCR_STB_MASK        0x04u
+#define LCR_STB_SHIFT       2u
+
+#define LCR_PEN_OFFSET      0x0Cu
+#define LCR_PEN_MASK        0x08u
+#define LCR_PEN_SHIFT       3u
+
+#define LCR_EPS_OFFSET      0x0Cu
+#define LCR_EPS_MASK        0x10u
+#define LCR_EPS_SHIFT       4u
+
+/*
+ * Divisor latch access.
+ */
+#define LCR_DLAB_OFFSET     0x0Cu
+#define LCR_DLAB_MASK       0x80u
+#define LCR_DLAB_SHIFT      7u
+
+/*------------------------------------------------------------------------------
+ * MCR: Modem Control Register
+ */
+#define MCR_REG_OFFSET      0x10u
+
+/*
+ * Internal loopback.
+ */
+#define MCR_LOOP_OFFSET     0x10u
+#define MCR_LOOP_MASK       0x10u
+#define MCR_LOOP_SHIFT      4u
+
+/*------------------------------------------------------------------------------
+ * LSR: Line Status Register
+ */
+#define LSR_REG_OFFSET      0x14u
+
+/*
+ * Data ready.
+ */
+#define LSR_DR_OFFSET       0x14u
+#define LSR_DR_MASK         0x01u
+#define LSR_DR_SHIFT        0u
+
+/*
+ * Overrun error.
+ */
+#define LSR_OE_OFFSET       0x14u
+#define LSR_OE_MASK         0x02u
+#define LSR_OE_SHIFT        1u
+
+/*
+ * Parity error.
+ */
+#define LSR_PE_OFFSET       0x14u
+#define LSR_PE_MASK         0x04u
+#define LSR_PE_SHIFT        2u
+
+/*
+ * Framing error.
+ */
+#define LSR_FE_OFFSET       0x14u
+#define LSR_FE_MASK         0x08u
+#define LSR_FE_SHIFT        3u
+
+/*
+ * Break interrupt.
+ */
+#define LSR_BI_OFFSET       0x14u
+#define LSR_BI_MASK         0x10u
+#define LSR_BI_SHIFT        4u
+
+/*
+ * Transmitter holding register (transmit FIFO) empty.
+ */
+#define LSR_THRE_OFFSET     0x14u
+#define LSR_THRE_MASK       0x20u
+#define LSR_THRE_SHIFT      5u
+
+/*
+ * Transmitter empty, including the shift register.
+ */
+#define LSR_TEMT_OFFSET     0x14u
+#define LSR_TEMT_MASK       0x40u
+#define LSR_TEMT_SHIFT      6u
+
+/*------------------------------------------------------------------------------
+ * MSR: Modem Status Register
+ */
+#define MSR_REG_OFFSET      0x18u
+
+/*------------------------------------------------------------------------------
+ * SR: Scratch Register
+ */
+#define SR_REG_OFFSET       0x1Cu
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* __CORE_16550_REGISTERS_H */
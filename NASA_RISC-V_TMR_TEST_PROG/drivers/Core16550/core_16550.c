@@ -0,0 +1,622 @@
+/**
+ * @file 	core_16550.c
+ * @author	Zac Carico
+ * @date 	Oct 16 2026
+ *
+ * @brief	Core16550 bare metal driver implementation
+ */
+#include "../../hal/hal.h"
+#include "core16550_regs.h"
+#include "core_16550.h"
+#include "../../hal/hal_assert.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NULL_INSTANCE ( ( uart_16550_instance_t* ) 0 )
+#define NULL_BUFFER   ( ( uint8_t* ) 0 )
+
+#define MAX_LINE_CONFIG     ( ( uint8_t )( UART_16550_DATA_8_BITS | \
+                                           UART_16550_TWO_STOP_BITS | \
+                                           UART_16550_EVEN_PARITY ) )
+#define LSR_ERROR_MASK      ( ( uint8_t )( LSR_OE_MASK | LSR_PE_MASK | \
+                                           LSR_FE_MASK | LSR_BI_MASK ) )
+#define FCR_FIFO_ENABLE     ( (uint8_t) (0x01) )
+
+static void fill_tx_fifo_from_ring
+(
+    uart_16550_instance_t * this_uart
+);
+
+static void drain_rx_fifo_to_ring
+(
+    uart_16550_instance_t * this_uart
+);
+
+static size_t ring_tx_pending
+(
+    const uart_16550_instance_t * this_uart
+);
+
+/***************************************************************************//**
+ * UART_16550_init()
+ * See "core_16550.h" for details of how to use this function.
+ */
+void
+UART_16550_init
+(
+    uart_16550_instance_t * this_uart,
+    addr_t base_addr,
+    uint16_t baud_value,
+    uint8_t line_config
+)
+{
+    HAL_ASSERT( this_uart != NULL_INSTANCE )
+    HAL_ASSERT( line_config <= MAX_LINE_CONFIG )
+    HAL_ASSERT( baud_value > 0u )
+
+    if( ( this_uart != NULL_INSTANCE ) &&
+        ( line_config <= MAX_LINE_CONFIG ) &&
+        ( baud_value > 0u ) )
+    {
+        this_uart->base_address = base_addr;
+
+        /* Disable every interrupt source before changing anything else. */
+        HAL_set_8bit_reg( base_addr, IER, 0u );
+
+        /* Baud rate divisor is written with the divisor latch selected. */
+        HAL_set_8bit_reg( base_addr, LCR, LCR_DLAB_MASK );
+        HAL_set_8bit_reg( base_addr, DLR, (uint_fast8_t)( baud_value & 0xFFu ) );
+        HAL_set_8bit_reg( base_addr, DMR, (uint_fast8_t)( baud_value >> 8 ) );
+        HAL_set_8bit_reg( base_addr, LCR, (uint_fast8_t)line_config );
+
+        this_uart->fcr = (uint8_t)( FCR_FIFO_ENABLE | UART_16550_FIFO_SINGLE_BYTE );
+        HAL_set_8bit_reg( base_addr, FCR, (uint_fast8_t)( this_uart->fcr |
+                                                           FCR_CLEAR_RX_MASK |
+                                                           FCR_CLEAR_TX_MASK ) );
+        HAL_set_8bit_reg( base_addr, MCR, 0u );
+
+        /* Clear any stale line status and received character. */
+        (void)HAL_get_8bit_reg( base_addr, LSR );
+        (void)HAL_get_8bit_reg( base_addr, RBR );
+
+        this_uart->status = 0u;
+        this_uart->tx_ring_buffer = NULL_BUFFER;
+        this_uart->tx_ring_size = 0u;
+        this_uart->tx_ring_head = 0u;
+        this_uart->tx_ring_tail = 0u;
+        this_uart->rx_ring_buffer = NULL_BUFFER;
+        this_uart->rx_ring_size = 0u;
+        this_uart->rx_ring_head = 0u;
+        this_uart->rx_ring_tail = 0u;
+    }
+}
+
+/***************************************************************************//**
+ * UART_16550_polled_tx()
+ * See "core_16550.h" for details of how to use this function.
+ */
+void
+UART_16550_polled_tx
+(
+    uart_16550_instance_t * this_uart,
+    const uint8_t * tx_buffer,
+    size_t tx_size
+)
+{
+    size_t size_sent = 0u;
+
+    HAL_ASSERT( this_uart != NULL_INSTANCE )
+    HAL_ASSERT( tx_buffer != NULL_BUFFER )
+
+    if( ( this_uart != NULL_INSTANCE ) && ( tx_buffer != NULL_BUFFER ) )
+    {
+        while( size_sent < tx_size )
+        {
+            if( this_uart->tx_ring_buffer != NULL_BUFFER )
+            {
+                size_sent += UART_16550_queue_tx( this_uart, &tx_buffer[size_sent],
+                                                  tx_size - size_sent );
+            }
+            else
+            {
+                size_sent += UART_16550_fill_tx_fifo( this_uart, &tx_buffer[size_sent],
+                                                      tx_size - size_sent );
+            }
+        }
+    }
+}
+
+/***************************************************************************//**
+ * UART_16550_polled_tx_string()
+ * See "core_16550.h" for details of how to use this function.
+ */
+void
+UART_16550_polled_tx_string
+(
+    uart_16550_instance_t * this_uart,
+    const uint8_t * p_sz_string
+)
+{
+    size_t char_idx = 0u;
+
+    HAL_ASSERT( p_sz_string != NULL_BUFFER )
+
+    if( p_sz_string != NULL_BUFFER )
+    {
+        while( 0u != p_sz_string[char_idx] )
+        {
+            char_idx++;
+        }
+        UART_16550_polled_tx( this_uart, p_sz_string, char_idx );
+    }
+}
+
+/***************************************************************************//**
+ * UART_16550_fill_tx_fifo()
+ * See "core_16550.h" for details of how to use this function.
+ */
+size_t
+UART_16550_fill_tx_fifo
+(
+    uart_16550_instance_t * this_uart,
+    const uint8_t * tx_buffer,
+    size_t tx_size
+)
+{
+    size_t size_sent = 0u;
+
+    HAL_ASSERT( this_uart != NULL_INSTANCE )
+    HAL_ASSERT( tx_buffer != NULL_BUFFER )
+
+    if( ( this_uart != NULL_INSTANCE ) && ( tx_buffer != NULL_BUFFER ) &&
+        ( HAL_get_8bit_reg( this_uart->base_address, LSR ) & LSR_THRE_MASK ) )
+    {
+        /* THRE means the whole FIFO is empty, so a full burst fits. */
+        if( tx_size > UART_16550_FIFO_DEPTH )
+        {
+            tx_size = UART_16550_FIFO_DEPTH;
+        }
+        while( size_sent < tx_size )
+        {
+            HAL_set_8bit_reg( this_uart->base_address, THR,
+                              (uint_fast8_t)tx_buffer[size_sent] );
+            size_sent++;
+        }
+    }
+    return size_sent;
+}
+
+/***************************************************************************//**
+ * UART_16550_get_rx()
+ * See "core_16550.h" for details of how to use this function.
+ */
+size_t
+UART_16550_get_rx
+(
+    uart_16550_instance_t * this_uart,
+    uint8_t * rx_buffer,
+    size_t buff_size
+)
+{
+    uint8_t lsr;
+    size_t rx_idx = 0u;
+    size_t tail;
+    psr_t saved_psr;
+
+    HAL_ASSERT( this_uart != NULL_INSTANCE )
+    HAL_ASSERT( rx_buffer != NULL_BUFFER )
+
+    if( ( this_uart != NULL_INSTANCE ) && ( rx_buffer != NULL_BUFFER ) &&
+        ( this_uart->rx_ring_buffer != NULL_BUFFER ) )
+    {
+        /*
+         * Only the tail index is written here, but the FIFO is drained first
+         * so data below the trigger level is not left waiting for the
+         * character timeout.
+         */
+        saved_psr = HAL_disable_interrupts();
+        drain_rx_fifo_to_ring( this_uart );
+        HAL_restore_interrupts( saved_psr );
+
+        tail = this_uart->rx_ring_tail;
+        while( ( tail != this_uart->rx_ring_head ) && ( rx_idx < buff_size ) )
+        {
+            rx_buffer[rx_idx] = this_uart->rx_ring_buffer[tail];
+            rx_idx++;
+            tail++;
+            if( tail == this_uart->rx_ring_size )
+            {
+                tail = 0u;
+            }
+        }
+        this_uart->rx_ring_tail = tail;
+    }
+    else if( ( this_uart != NULL_INSTANCE ) && ( rx_buffer != NULL_BUFFER ) )
+    {
+        lsr = HAL_get_8bit_reg( this_uart->base_address, LSR );
+        this_uart->status |= lsr & LSR_ERROR_MASK;
+        while( ( lsr & LSR_DR_MASK ) && ( rx_idx < buff_size ) )
+        {
+            rx_buffer[rx_idx] = HAL_get_8bit_reg( this_uart->base_address, RBR );
+            rx_idx++;
+            lsr = HAL_get_8bit_reg( this_uart->base_address, LSR );
+            this_uart->status |= lsr & LSR_ERROR_MASK;
+        }
+    }
+    return rx_idx;
+}
+
+/***************************************************************************//**
+ * UART_16550_get_rx_status()
+ * See "core_16550.h" for details of how to use this function.
+ */
+uint8_t
+UART_16550_get_rx_status
+(
+    uart_16550_instance_t * this_uart
+)
+{
+    uint8_t status = UART_16550_INVALID_PARAM;
+    psr_t saved_psr;
+
+    HAL_ASSERT( this_uart != NULL_INSTANCE )
+
+    if( this_uart != NULL_INSTANCE )
+    {
+        saved_psr = HAL_disable_interrupts();
+        this_uart->status |= HAL_get_8bit_reg( this_uart->base_address, LSR ) &
+                                                               LSR_ERROR_MASK;
+        status = this_uart->status;
+        this_uart->status = 0u;
+        HAL_restore_interrupts( saved_psr );
+    }
+    return status;
+}
+
+/***************************************************************************//**
+ * UART_16550_set_loopback()
+ * See "core_16550.h" for details of how to use this function.
+ */
+void
+UART_16550_set_loopback
+(
+    uart_16550_instance_t * this_uart,
+    uint8_t loopback
+)
+{
+    HAL_ASSERT( this_uart != NULL_INSTANCE )
+
+    if( this_uart != NULL_INSTANCE )
+    {
+        HAL_set_8bit_reg_field( this_uart->base_address, MCR_LOOP,
+                                ( loopback != 0u ) ? 1u : 0u );
+    }
+}
+
+/***************************************************************************//**
+ * UART_16550_set_tx_ring_buffer()
+ * See "core_16550.h" for details of how to use this function.
+ */
+void
+UART_16550_set_tx_ring_buffer
+(
+    uart_16550_instance_t * this_uart,
+    uint8_t * tx_ring,
+    size_t ring_size
+)
+{
+    psr_t saved_psr;
+
+    HAL_ASSERT( this_uart != NULL_INSTANCE )
+    HAL_ASSERT( ( tx_ring == NULL_BUFFER ) || ( ring_size > 1u ) )
+
+    if( ( this_uart != NULL_INSTANCE ) &&
+        ( ( tx_ring == NULL_BUFFER ) || ( ring_size > 1u ) ) )
+    {
+        saved_psr = HAL_disable_interrupts();
+        HAL_set_8bit_reg_field( this_uart->base_address, IER_ETBEI, 0u );
+        this_uart->tx_ring_head = 0u;
+        this_uart->tx_ring_tail = 0u;
+        this_uart->tx_ring_size = ( tx_ring == NULL_BUFFER ) ? 0u : ring_size;
+        this_uart->tx_ring_buffer = tx_ring;
+        HAL_restore_interrupts( saved_psr );
+    }
+}
+
+/***************************************************************************//**
+ * UART_16550_queue_tx()
+ * See "core_16550.h" for details of how to use this function.
+ */
+size_t
+UART_16550_queue_tx
+(
+    uart_16550_instance_t * this_uart,
+    const uint8_t * tx_buffer,
+    size_t tx_size
+)
+{
+    size_t head;
+    size_t next;
+    size_t size_queued = 0u;
+    psr_t saved_psr;
+
+    HAL_ASSERT( this_uart != NULL_INSTANCE )
+    HAL_ASSERT( tx_buffer != NULL_BUFFER )
+
+    if( ( this_uart != NULL_INSTANCE ) && ( tx_buffer != NULL_BUFFER ) &&
+        ( this_uart->tx_ring_buffer != NULL_BUFFER ) )
+    {
+        /*
+         * Only the head index is written here and only the tail index is
+         * written by UART_16550_isr(), so copying needs no critical section.
+         */
+        head = this_uart->tx_ring_head;
+        while( size_queued < tx_size )
+        {
+            next = head + 1u;
+            if( next == this_uart->tx_ring_size )
+            {
+                next = 0u;
+            }
+            if( next == this_uart->tx_ring_tail )
+            {
+                break;
+            }
+            this_uart->tx_ring_buffer[head] = tx_buffer[size_queued];
+            head = next;
+            size_queued++;
+        }
+        this_uart->tx_ring_head = head;
+
+        if( size_queued > 0u )
+        {
+            /*
+             * IER is also changed by UART_16550_isr(). Setting ETBEI while the
+             * FIFO is empty raises the interrupt straight away.
+             */
+            saved_psr = HAL_disable_interrupts();
+            HAL_set_8bit_reg_field( this_uart->base_address, IER_ETBEI, 1u );
+            HAL_restore_interrupts( saved_psr );
+        }
+    }
+    return size_queued;
+}
+
+/***************************************************************************//**
+ * UART_16550_get_tx_pending()
+ * See "core_16550.h" for details of how to use this function.
+ */
+size_t
+UART_16550_get_tx_pending
+(
+    uart_16550_instance_t * this_uart
+)
+{
+    size_t pending = 0u;
+
+    HAL_ASSERT( this_uart != NULL_INSTANCE )
+
+    if( ( this_uart != NULL_INSTANCE ) &&
+        ( this_uart->tx_ring_buffer != NULL_BUFFER ) )
+    {
+        pending = ring_tx_pending( this_uart );
+    }
+    return pending;
+}
+
+/***************************************************************************//**
+ * UART_16550_tx_flush()
+ * See "core_16550.h" for details of how to use this function.
+ */
+void
+UART_16550_tx_flush
+(
+    uart_16550_instance_t * this_uart
+)
+{
+    psr_t saved_psr;
+
+    HAL_ASSERT( this_uart != NULL_INSTANCE )
+
+    if( this_uart != NULL_INSTANCE )
+    {
+        while( UART_16550_get_tx_pending( this_uart ) > 0u )
+        {
+            saved_psr = HAL_disable_interrupts();
+            fill_tx_fifo_from_ring( this_uart );
+            HAL_restore_interrupts( saved_psr );
+        }
+    }
+}
+
+/***************************************************************************//**
+ * UART_16550_set_rx_ring_buffer()
+ * See "core_16550.h" for details of how to use this function.
+ */
+void
+UART_16550_set_rx_ring_buffer
+(
+    uart_16550_instance_t * this_uart,
+    uint8_t * rx_ring,
+    size_t ring_size,
+    uint8_t trigger_level
+)
+{
+    psr_t saved_psr;
+
+    HAL_ASSERT( this_uart != NULL_INSTANCE )
+    HAL_ASSERT( ( rx_ring == NULL_BUFFER ) || ( ring_size > 1u ) )
+    HAL_ASSERT( ( trigger_level & ~FCR_TRIG_LEVEL_MASK ) == 0u )
+
+    if( ( this_uart != NULL_INSTANCE ) &&
+        ( ( rx_ring == NULL_BUFFER ) || ( ring_size > 1u ) ) )
+    {
+        saved_psr = HAL_disable_interrupts();
+        this_uart->rx_ring_head = 0u;
+        this_uart->rx_ring_tail = 0u;
+        this_uart->rx_ring_size = ( rx_ring == NULL_BUFFER ) ? 0u : ring_size;
+        this_uart->rx_ring_buffer = rx_ring;
+
+        this_uart->fcr = (uint8_t)( ( this_uart->fcr & ~FCR_TRIG_LEVEL_MASK ) |
+                                    ( trigger_level & FCR_TRIG_LEVEL_MASK ) );
+        HAL_set_8bit_reg( this_uart->base_address, FCR, (uint_fast8_t)this_uart->fcr );
+
+        if( rx_ring == NULL_BUFFER )
+        {
+            HAL_set_8bit_reg_field( this_uart->base_address, IER_ERBFI, 0u );
+            HAL_set_8bit_reg_field( this_uart->base_address, IER_ELSI, 0u );
+        }
+        else
+        {
+            HAL_set_8bit_reg_field( this_uart->base_address, IER_ERBFI, 1u );
+            HAL_set_8bit_reg_field( this_uart->base_address, IER_ELSI, 1u );
+        }
+        HAL_restore_interrupts( saved_psr );
+    }
+}
+
+/***************************************************************************//**
+ * UART_16550_isr()
+ * See "core_16550.h" for details of how to use this function.
+ */
+void
+UART_16550_isr
+(
+    uart_16550_instance_t * this_uart
+)
+{
+    uint8_t iid;
+
+    HAL_ASSERT( this_uart != NULL_INSTANCE )
+
+    if( this_uart != NULL_INSTANCE )
+    {
+        iid = HAL_get_8bit_reg( this_uart->base_address, IIR ) & IIR_IID_MASK;
+        while( iid != IIR_IID_NONE )
+        {
+            switch( iid )
+            {
+                case IIR_IID_RX_LINE_STATUS:
+                case IIR_IID_RX_DATA:
+                case IIR_IID_RX_TIMEOUT:
+                    /* Reading LSR and RBR clears all three. */
+                    drain_rx_fifo_to_ring( this_uart );
+                    break;
+
+                case IIR_IID_THR_EMPTY:
+                    /* Reading IIR cleared it, refill or stop. */
+                    fill_tx_fifo_from_ring( this_uart );
+                    if( ring_tx_pending( this_uart ) == 0u )
+                    {
+                        HAL_set_8bit_reg_field( this_uart->base_address,
+                                                IER_ETBEI, 0u );
+                    }
+                    break;
+
+                default:
+                    /* Modem status is not used, reading MSR clears it. */
+                    (void)HAL_get_8bit_reg( this_uart->base_address, MSR );
+                    break;
+            }
+            iid = HAL_get_8bit_reg( this_uart->base_address, IIR ) & IIR_IID_MASK;
+        }
+    }
+}
+
+/*------------------------------------------------------------------------------
+ * Writes up to one FIFO's worth of the transmit ring buffer if the transmit
+ * FIFO is empty. Called with interrupts disabled.
+ */
+static void fill_tx_fifo_from_ring
+(
+    uart_16550_instance_t * this_uart
+)
+{
+    size_t tail;
+    size_t count = 0u;
+
+    if( ( this_uart->tx_ring_buffer != NULL_BUFFER ) &&
+        ( HAL_get_8bit_reg( this_uart->base_address, LSR ) & LSR_THRE_MASK ) )
+    {
+        tail = this_uart->tx_ring_tail;
+        while( ( tail != this_uart->tx_ring_head ) &&
+               ( count < UART_16550_FIFO_DEPTH ) )
+        {
+            HAL_set_8bit_reg( this_uart->base_address, THR,
+                              (uint_fast8_t)this_uart->tx_ring_buffer[tail] );
+            count++;
+            tail++;
+            if( tail == this_uart->tx_ring_size )
+            {
+                tail = 0u;
+            }
+        }
+        this_uart->tx_ring_tail = tail;
+    }
+}
+
+/*------------------------------------------------------------------------------
+ * Moves every character in the receive FIFO into the receive ring buffer,
+ * recording line errors. Characters that do not fit are dropped and reported
+ * as an overrun. Called with interrupts disabled.
+ */
+static void drain_rx_fifo_to_ring
+(
+    uart_16550_instance_t * this_uart
+)
+{
+    uint8_t lsr;
+    uint8_t rx_char;
+    size_t head;
+    size_t next;
+
+    if( this_uart->rx_ring_buffer != NULL_BUFFER )
+    {
+        head = this_uart->rx_ring_head;
+        lsr = HAL_get_8bit_reg( this_uart->base_address, LSR );
+        while( lsr & LSR_DR_MASK )
+        {
+            this_uart->status |= lsr & LSR_ERROR_MASK;
+            rx_char = HAL_get_8bit_reg( this_uart->base_address, RBR );
+            next = head + 1u;
+            if( next == this_uart->rx_ring_size )
+            {
+                next = 0u;
+            }
+            if( next == this_uart->rx_ring_tail )
+            {
+                this_uart->status |= LSR_OE_MASK;
+            }
+            else
+            {
+                this_uart->rx_ring_buffer[head] = rx_char;
+                head = next;
+            }
+            lsr = HAL_get_8bit_reg( this_uart->base_address, LSR );
+        }
+        this_uart->status |= lsr & LSR_ERROR_MASK;
+        this_uart->rx_ring_head = head;
+    }
+}
+
+/*------------------------------------------------------------------------------
+ * Number of bytes waiting in the transmit ring buffer.
+ */
+static size_t ring_tx_pending
+(
+    const uart_16550_instance_t * this_uart
+)
+{
+    size_t head = this_uart->tx_ring_head;
+    size_t tail = this_uart->tx_ring_tail;
+
+    return ( head >= tail ) ? ( head - tail )
+                            : ( ( this_uart->tx_ring_size - tail ) + head );
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,310 @@
+/**
+ * @file 	core_16550.h
+ * @author	Zac Carico
+ * @date 	Oct 16 2026
+ *
+ * @brief	Core16550 bare metal driver public API
+ */
+/*=========================================================================*//**
+  @mainpage Core16550 Bare Metal Driver.
+
+  @section intro_sec Introduction
+  Core16550 is a 16550 compatible UART with 16 byte transmit and receive FIFOs.
+  This driver moves data to and from the FIFOs in bursts of up to 16 bytes, so
+  a transmitter or receiver interrupt is taken once per burst instead of once
+  per character as with CoreUARTapb.
+
+  @section init Initialization
+  The driver is initialized with UART_16550_init(), which sets the baud rate
+  divisor and line configuration, clears both FIFOs and disables every
+  Core16550 interrupt.
+
+  @section polled Polled Transfers
+  UART_16550_polled_tx() and UART_16550_polled_tx_string() wait for the
+  transmit FIFO to empty and then write up to 16 bytes at once.
+  UART_16550_fill_tx_fifo() writes one burst without waiting.
+  UART_16550_get_rx() drains the receive FIFO.
+
+  @section irq Interrupt-Driven Streaming
+  A transmit ring buffer is attached with UART_16550_set_tx_ring_buffer() and
+  filled with UART_16550_queue_tx(). A receive ring buffer is attached with
+  UART_16550_set_rx_ring_buffer(), which also sets the receive FIFO trigger
+  level. UART_16550_isr() must then be called from the interrupt handler of
+  the Core16550 INTR signal. Unlike CoreUARTapb, Core16550 masks its own
+  interrupt sources, so the PLIC input can stay enabled.
+*//*=========================================================================*/
+#ifndef __CORE_16550_H
+#define __CORE_16550_H  1
+
+#include "../../hal/cpu_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************//**
+ * Line configuration, a logical OR of one value from each group, passed to
+ * UART_16550_init():
+ */
+#define UART_16550_DATA_5_BITS      0x00u
+#define UART_16550_DATA_6_BITS      0x01u
+#define UART_16550_DATA_7_BITS      0x02u
+#define UART_16550_DATA_8_BITS      0x03u
+
+#define UART_16550_ONE_STOP_BIT     0x00u
+#define UART_16550_TWO_STOP_BITS    0x04u
+
+#define UART_16550_NO_PARITY        0x00u
+#define UART_16550_ODD_PARITY       0x08u
+#define UART_16550_EVEN_PARITY      0x18u
+
+/***************************************************************************//**
+ * Receive FIFO trigger levels, passed to UART_16550_set_rx_ring_buffer(). The
+ * receive interrupt is raised once the FIFO holds this many characters, or
+ * when characters have been waiting for four character times.
+ */
+#define UART_16550_FIFO_SINGLE_BYTE 0x00u
+#define UART_16550_FIFO_FOUR_BYTES  0x40u
+#define UART_16550_FIFO_EIGHT_BYTES 0x80u
+#define UART_16550_FIFO_FOURTEEN_BYTES  0xC0u
+
+/***************************************************************************//**
+ * Depth of the transmit and receive FIFOs.
+ */
+#define UART_16550_FIFO_DEPTH       16u
+
+/***************************************************************************//**
+ * Error status returned by UART_16550_get_rx_status(), a logical OR of:
+ */
+#define UART_16550_NO_ERROR         0x00u
+#define UART_16550_OVERRUN_ERROR    0x02u
+#define UART_16550_PARITY_ERROR     0x04u
+#define UART_16550_FRAMING_ERROR    0x08u
+#define UART_16550_BREAK_ERROR      0x10u
+#define UART_16550_INVALID_PARAM    0xFFu
+
+/***************************************************************************//**
+ * uart_16550_instance_t
+ *
+ * There should be one instance of this structure for each instance of
+ * Core16550 in your system. The 'status' element holds the receive errors
+ * seen since the last call to UART_16550_get_rx_status(). The 'fcr' element
+ * is a copy of the write-only FIFO control register.
+ */
+typedef struct uart_16550_instance
+{
+    addr_t      base_address;
+    uint8_t     status;
+    uint8_t     fcr;
+
+    /* Transmit ring buffer, filled by UART_16550_queue_tx(), drained by UART_16550_isr() */
+    uint8_t *       tx_ring_buffer;
+    size_t          tx_ring_size;
+    volatile size_t tx_ring_head;
+    volatile size_t tx_ring_tail;
+
+    /* Receive ring buffer, filled by UART_16550_isr(), drained by UART_16550_get_rx() */
+    uint8_t *       rx_ring_buffer;
+    size_t          rx_ring_size;
+    volatile size_t rx_ring_head;
+    volatile size_t rx_ring_tail;
+} uart_16550_instance_t;
+
+/***************************************************************************//**
+ * The function UART_16550_init() initializes the Core16550 with the baud rate
+ * divisor and line configuration passed as parameters. Both FIFOs are cleared,
+ * every Core16550 interrupt is disabled and any ring buffers are detached.
+ *
+ * @param this_uart   Pointer to the uart_16550_instance_t of this Core16550.
+ * @param base_addr   Base address of the Core16550 registers.
+ * @param baud_value  Baud rate divisor: baud_value = clock / (baud_rate * 16).
+ * @param line_config Logical OR of a data length, stop bits and parity define.
+ *
+ * Example:
+ * @code
+ *   UART_16550_init(&g_uart_16550, CORE16550_BASE_ADDR,
+ *                   CORE16550_BAUD_VALUE_115200,
+ *                   UART_16550_DATA_8_BITS | UART_16550_NO_PARITY);
+ * @endcode
+ */
+void
+UART_16550_init
+(
+    uart_16550_instance_t * this_uart,
+    addr_t base_addr,
+    uint16_t baud_value,
+    uint8_t line_config
+);
+
+/***************************************************************************//**
+ * The function UART_16550_polled_tx() transmits tx_size bytes. Each time the
+ * transmit FIFO is empty it is filled with up to 16 bytes. Returns once the
+ * last byte is in the FIFO.
+ *
+ * Note: if a transmit ring buffer is attached the data is queued instead and
+ * this function only waits while the ring buffer is full.
+ */
+void
+UART_16550_polled_tx
+(
+    uart_16550_instance_t * this_uart,
+    const uint8_t * tx_buffer,
+    size_t tx_size
+);
+
+/***************************************************************************//**
+ * The function UART_16550_polled_tx_string() transmits a null terminated
+ * string in the same way as UART_16550_polled_tx().
+ */
+void
+UART_16550_polled_tx_string
+(
+    uart_16550_instance_t * this_uart,
+    const uint8_t * p_sz_string
+);
+
+/***************************************************************************//**
+ * The function UART_16550_fill_tx_fifo() writes up to 16 bytes to the transmit
+ * FIFO if it is empty and returns without waiting.
+ *
+ * @return  The number of bytes written to the FIFO, 0 if it was not empty.
+ */
+size_t
+UART_16550_fill_tx_fifo
+(
+    uart_16550_instance_t * this_uart,
+    const uint8_t * tx_buffer,
+    size_t tx_size
+);
+
+/***************************************************************************//**
+ * The function UART_16550_get_rx() reads up to buff_size received bytes. The
+ * bytes come from the receive ring buffer if one is attached, otherwise the
+ * receive FIFO is drained directly. Receive errors are accumulated for
+ * UART_16550_get_rx_status().
+ *
+ * @return  The number of bytes read, 0 if none were waiting.
+ */
+size_t
+UART_16550_get_rx
+(
+    uart_16550_instance_t * this_uart,
+    uint8_t * rx_buffer,
+    size_t buff_size
+);
+
+/***************************************************************************//**
+ * The function UART_16550_get_rx_status() returns the receive errors seen since
+ * it was last called, as a logical OR of UART_16550_OVERRUN_ERROR,
+ * UART_16550_PARITY_ERROR, UART_16550_FRAMING_ERROR and UART_16550_BREAK_ERROR,
+ * or UART_16550_NO_ERROR. An overrun is also reported when the receive ring
+ * buffer was full.
+ */
+uint8_t
+UART_16550_get_rx_status
+(
+    uart_16550_instance_t * this_uart
+);
+
+/***************************************************************************//**
+ * The function UART_16550_set_loopback() connects the transmitter to the
+ * receiver inside the Core16550 when loopback is non-zero, and back to the
+ * pins when it is zero.
+ */
+void
+UART_16550_set_loopback
+(
+    uart_16550_instance_t * this_uart,
+    uint8_t loopback
+);
+
+/***************************************************************************//**
+ * The function UART_16550_set_tx_ring_buffer() attaches a transmit ring buffer
+ * that is drained by UART_16550_isr(), 16 bytes per transmit FIFO empty
+ * interrupt. Passing a null tx_ring detaches the ring buffer; any data still
+ * queued is discarded.
+ *
+ * @param tx_ring   Ring buffer storage. Holds ring_size - 1 bytes.
+ * @param ring_size Size of tx_ring in bytes, at least 2.
+ */
+void
+UART_16550_set_tx_ring_buffer
+(
+    uart_16550_instance_t * this_uart,
+    uint8_t * tx_ring,
+    size_t ring_size
+);
+
+/***************************************************************************//**
+ * The function UART_16550_queue_tx() copies as much of tx_buffer as fits into
+ * the transmit ring buffer and enables the transmit FIFO empty interrupt. It
+ * never waits.
+ *
+ * @return  The number of bytes queued.
+ */
+size_t
+UART_16550_queue_tx
+(
+    uart_16550_instance_t * this_uart,
+    const uint8_t * tx_buffer,
+    size_t tx_size
+);
+
+/***************************************************************************//**
+ * The function UART_16550_get_tx_pending() returns the number of bytes in the
+ * transmit ring buffer that have not been written to the transmit FIFO.
+ */
+size_t
+UART_16550_get_tx_pending
+(
+    uart_16550_instance_t * this_uart
+);
+
+/***************************************************************************//**
+ * The function UART_16550_tx_flush() waits until the transmit ring buffer is
+ * empty. The ring is also drained from here, so it works with interrupts
+ * disabled.
+ */
+void
+UART_16550_tx_flush
+(
+    uart_16550_instance_t * this_uart
+);
+
+/***************************************************************************//**
+ * The function UART_16550_set_rx_ring_buffer() attaches a receive ring buffer
+ * that UART_16550_isr() fills, sets the receive FIFO trigger level and enables
+ * the receive data and line status interrupts. Passing a null rx_ring detaches
+ * the ring buffer and disables those interrupts.
+ *
+ * @param rx_ring       Ring buffer storage. Holds ring_size - 1 bytes.
+ * @param ring_size     Size of rx_ring in bytes, at least 2.
+ * @param trigger_level One of the UART_16550_FIFO_* trigger levels.
+ */
+void
+UART_16550_set_rx_ring_buffer
+(
+    uart_16550_instance_t * this_uart,
+    uint8_t * rx_ring,
+    size_t ring_size,
+    uint8_t trigger_level
+);
+
+/***************************************************************************//**
+ * The function UART_16550_isr() services every pending Core16550 interrupt. It
+ * must be called from the interrupt handler of the Core16550 INTR signal. The
+ * receive FIFO is drained completely into the receive ring buffer, and the
+ * transmit FIFO is refilled with up to 16 bytes from the transmit ring buffer.
+ * The transmit FIFO empty interrupt is disabled once the ring buffer is empty.
+ */
+void
+UART_16550_isr
+(
+    uart_16550_instance_t * this_uart
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CORE_16550_H */
@@ -73,6 +73,8 @@ extern "C" {
  */
 #define MAX_OFFSET_LENGTH       2u
 
+#define NULL_MASTER_DONE_HANDLER ( ( i2c_master_done_handler_t ) 0u )
+
 /*------------------------------------------------------------------------------
  * I2C interrupts control functions implemented "i2c_interrupt.c".
  * the implementation of these functions depend on the underlying hardware
@@ -81,7 +83,17 @@ extern "C" {
  */
 void I2C_enable_irq( i2c_instance_t * this_i2c );
 void I2C_disable_irq( i2c_instance_t * this_i2c );
+uint8_t I2C_disable_irq_save( i2c_instance_t * this_i2c );
+void I2C_restore_irq( i2c_instance_t * this_i2c, uint8_t was_enabled );
+
+/*------------------------------------------------------------------------------
+ * Time base of the master time outs, also implemented in "i2c_interrupt.c".
+ */
+uint64_t I2C_get_time( void );
+uint64_t I2C_ms_to_time( uint32_t ms );
+
 static void enable_slave_if_required(i2c_instance_t * this_i2c);
+static void check_master_timeout(i2c_instance_t * this_i2c);
 
 /*------------------------------------------------------------------------------
  * I2C_init()
@@ -422,6 +434,9 @@ i2c_status_t I2C_get_status
 {
     i2c_status_t i2c_status ;
 
+    /* Polling the status is what times out a transaction that is not waited for. */
+    check_master_timeout( this_i2c );
+
     i2c_status = this_i2c->master_status ;
 
     return i2c_status;
@@ -438,21 +453,21 @@ i2c_status_t I2C_wait_complete
 )
 {
     i2c_status_t i2c_status;
-    psr_t saved_psr;
+
+    I2C_set_timeout( this_i2c, timeout_ms );
+
     /*
-     * Because we have no idea of what CPU we are supposed to be running on
-     * we need to guard this write to the timeout value to avoid ISR/user code
-     * interaction issues. Checking the status below should be fine as only a
-     * single byte should change in that.
+     * Run the loop until state returns I2C_FAILED  or I2C_SUCESS. The deadline
+     * is checked here as well so that the time out does not depend on a tick.
      */
-    saved_psr = HAL_disable_interrupts();
-    this_i2c->master_timeout_ms = timeout_ms;
-    HAL_restore_interrupts( saved_psr );
-
-    /* Run the loop until state returns I2C_FAILED  or I2C_SUCESS*/
     do {
+        check_master_timeout( this_i2c );
         i2c_status = this_i2c->master_status;
     } while(I2C_IN_PROGRESS == i2c_status);
+
+    /* The transaction is over, so its deadline must not hit the next one. */
+    this_i2c->master_timeout_ms = I2C_NO_TIMEOUT;
+
     return i2c_status;
 }
 
@@ -466,39 +481,151 @@ void I2C_system_tick
     uint32_t ms_since_last_tick
 )
 {
-    if(this_i2c->master_timeout_ms != I2C_NO_TIMEOUT)
+    /*
+     * The deadline is kept against the free-running time base, so the tick
+     * period is not needed.
+     */
+    (void)ms_since_last_tick;
+
+    check_master_timeout( this_i2c );
+}
+
+/*------------------------------------------------------------------------------
+ * I2C_set_timeout()
+ * See "core_i2c.h" for details of how to use this function.
+ */
+void I2C_set_timeout
+(
+    i2c_instance_t * this_i2c,
+    uint32_t timeout_ms
+)
+{
+    psr_t saved_psr;
+    uint64_t deadline = 0u;
+
+    if(I2C_NO_TIMEOUT != timeout_ms)
     {
-       if(this_i2c->master_timeout_ms > ms_since_last_tick)
-        {
-            this_i2c->master_timeout_ms -= ms_since_last_tick;
-        }
-        else
-        {
-            psr_t saved_psr;
-            /*
-             * We need to disable interrupts here to ensure we can update the
-             * shared data without the I2C ISR interrupting us.
-             */
-            saved_psr = HAL_disable_interrupts();
+        deadline = I2C_get_time() + I2C_ms_to_time( timeout_ms );
+    }
 
-            /*
-             * Mark current transaction as having timed out.
-             */
-            this_i2c->master_status = I2C_TIMED_OUT;
-            this_i2c->transaction = NO_TRANSACTION;
-            this_i2c->is_transaction_pending = 0;
+    /*
+     * The deadline is checked from I2C_system_tick() as well as from the
+     * application, and is two words wide on a 32 bit CPU, so all interrupts
+     * are held off for the two writes.
+     */
+    saved_psr = HAL_disable_interrupts();
+    this_i2c->master_deadline = deadline;
+    this_i2c->master_timeout_ms = timeout_ms;
+    HAL_restore_interrupts( saved_psr );
+}
 
-            HAL_restore_interrupts( saved_psr );
-            
-            /*
-             * Make sure we do not incorrectly signal a timeout for subsequent
-             * transactions.
-             */
-            this_i2c->master_timeout_ms = I2C_NO_TIMEOUT;
-        }
+/*------------------------------------------------------------------------------
+ * Times out the current master transaction once its deadline has passed. The
+ * CoreI2C is reset so that it gives up the bus and does not carry on with the
+ * transaction in the background, and the done handler is told.
+ */
+static void check_master_timeout
+(
+    i2c_instance_t * this_i2c
+)
+{
+    psr_t saved_psr;
+    uint8_t saved_irq;
+    uint8_t expired = 0u;
+    uint64_t now;
+    i2c_status_t previous_status;
+
+    if(I2C_NO_TIMEOUT == this_i2c->master_timeout_ms)
+    {
+        return;
+    }
+
+    /*
+     * Quick check without any guard. The deadline may be read half written
+     * here, which only makes this check wrong; it is made again below.
+     */
+    now = I2C_get_time();
+    if(now < this_i2c->master_deadline)
+    {
+        return;
+    }
+
+    /*
+     * We need to mask this instance's interrupt here to ensure we can
+     * update the shared data without the I2C ISR interrupting us, and so
+     * that it can't end the transaction and start another one once the time
+     * out has been claimed. Other interrupt sources keep running.
+     */
+    saved_irq = I2C_disable_irq_save( this_i2c );
+
+    /*
+     * This runs from the application and from I2C_system_tick(), so the test
+     * and clear of the time out is done with all interrupts held off: only
+     * one caller can claim it, and the deadline is not read half written.
+     * Clearing it also makes sure we do not incorrectly signal a timeout for
+     * subsequent transactions.
+     */
+    saved_psr = HAL_disable_interrupts();
+    if( ( I2C_NO_TIMEOUT != this_i2c->master_timeout_ms ) &&
+        ( now >= this_i2c->master_deadline ) )
+    {
+        this_i2c->master_timeout_ms = I2C_NO_TIMEOUT;
+        expired = 1u;
+    }
+    HAL_restore_interrupts( saved_psr );
+
+    if(0u == expired)
+    {
+        I2C_restore_irq( this_i2c, saved_irq );
+        return;
+    }
+
+    previous_status = this_i2c->master_status;
+    if( I2C_IN_PROGRESS == previous_status )
+    {
+        /* Abort the transaction in the hardware and release the bus. */
+        HAL_set_8bit_reg_field(this_i2c->base_address, ENS1, 0x00); /* Reset I2C hardware. */
+        HAL_set_8bit_reg_field(this_i2c->base_address, ENS1, 0x01); /* set enable bit */
+        enable_slave_if_required( this_i2c );
+
+        this_i2c->master_status = I2C_TIMED_OUT;
+        this_i2c->transaction = NO_TRANSACTION;
+        this_i2c->is_transaction_pending = 0;
+        this_i2c->bus_status = I2C_RELEASE_BUS;
+    }
+
+    I2C_restore_irq( this_i2c, saved_irq );
+
+    if( ( I2C_IN_PROGRESS == previous_status ) &&
+        ( NULL_MASTER_DONE_HANDLER != this_i2c->master_done_handler ) )
+    {
+        this_i2c->master_done_handler( this_i2c, I2C_TIMED_OUT );
     }
 }
 
+/*------------------------------------------------------------------------------
+ * I2C_register_master_done_handler()
+ * See "core_i2c.h" for details of how to use this function.
+ */
+void I2C_register_master_done_handler
+(
+    i2c_instance_t * this_i2c,
+    i2c_master_done_handler_t handler
+)
+{
+    uint8_t saved_irq;
+
+    /*
+     * We need to mask this instance's interrupt here to ensure we can
+     * update the shared data without the I2C ISR interrupting us.
+     */
+    saved_irq = I2C_disable_irq_save( this_i2c );
+
+    this_i2c->master_done_handler = handler;
+
+    I2C_restore_irq( this_i2c, saved_irq );
+}
+
 /*------------------------------------------------------------------------------
  * I2C_set_slave_tx_buffer()
  * See "core_i2c.h" for details of how to use this function.
@@ -664,8 +791,8 @@ static void enable_slave_if_required
 )
 {
     /*
-     * This function is only called from within the ISR and so does not need
-     * guarding on the register access.
+     * This function is only called from within the ISR, or with the CoreI2C
+     * interrupt masked, and so does not need guarding on the register access.
      */
     if( 0 != this_i2c->is_slave_enabled )
     {
@@ -771,6 +898,7 @@ void I2C_isr
     uint8_t data;
     uint8_t hold_bus;
     uint8_t clear_irq = 1u;
+    i2c_status_t master_status_on_entry = this_i2c->master_status;
 
     status = HAL_get_8bit_reg( this_i2c->base_address, STATUS);
     
@@ -1235,6 +1363,29 @@ void I2C_isr
     /* Read the status register to ensure the last I2C registers write took place
      * in a system built around a bus making use of posted writes. */
     status = HAL_get_8bit_reg( this_i2c->base_address, STATUS);
+
+    /*
+     * Tell the application a master transaction has ended. This is done last
+     * so the handler can start the next transaction straight away.
+     */
+    if( ( I2C_IN_PROGRESS == master_status_on_entry ) &&
+        ( I2C_IN_PROGRESS != this_i2c->master_status ) )
+    {
+        if( NULL_MASTER_DONE_HANDLER != this_i2c->master_done_handler )
+        {
+            this_i2c->master_done_handler( this_i2c, this_i2c->master_status );
+        }
+
+        /*
+         * The transaction is over, so its deadline must not time out the
+         * next one. A transaction started from the handler keeps it, as the
+         * deadline may cover a whole chain of transactions.
+         */
+        if( I2C_IN_PROGRESS != this_i2c->master_status )
+        {
+            this_i2c->master_timeout_ms = I2C_NO_TIMEOUT;
+        }
+    }
 }
 
 /*------------------------------------------------------------------------------
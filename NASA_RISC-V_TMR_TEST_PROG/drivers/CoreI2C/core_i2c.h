@@ -274,9 +274,10 @@
     functions to initiate an I2C bus transaction. The application can then wait
     for the transaction to complete using the I2C_wait_complete() function
     or poll the status of the I2C transaction using the I2C_get_status()
-    function until it returns a value different from I2C_IN_PROGRESS. The
-    I2C_system_tick() function can be used to set a time base for the
-    I2C_wait_complete() functions time out delay.
+    function until it returns a value different from I2C_IN_PROGRESS. Time out
+    delays are kept against the free-running machine timer (MTIME) and are
+    checked by I2C_wait_complete() and I2C_get_status(), so no periodic tick
+    is needed; I2C_system_tick() remains for applications that prefer one.
 
   Slave Operations
     The configuration of the  I2C driver to operate as an I2C slave requires
@@ -549,6 +550,30 @@ typedef struct i2c_instance i2c_instance_t ;
  */
 typedef i2c_slave_handler_ret_t (*i2c_slave_wr_handler_t)(i2c_instance_t *instance, uint8_t *, uint16_t );
 
+/*-------------------------------------------------------------------------*//**
+  Master completion handler functions prototype.
+  ------------------------------------------------------------------------------
+  This defines the function prototype that must be followed by I2C master
+  completion handler functions. These functions are registered with the CoreI2C
+  driver through the I2C_register_master_done_handler() function.
+
+  Declaring and Implementing Master Completion Handler Functions:
+    Master completion handler functions should follow the following prototype:
+    void done_handler( i2c_instance_t *instance, i2c_status_t status );
+
+    The instance parameter is a pointer to the i2c_instance_t of the channel
+    whose master transaction has ended.
+
+    The status parameter is the outcome of the transaction: I2C_SUCCESS,
+    I2C_FAILED or I2C_TIMED_OUT.
+
+    The handler is called from I2C_isr(), or for a time out from whichever of
+    I2C_get_status(), I2C_wait_complete() or I2C_system_tick() sees the
+    deadline pass, so it must be short. It may start the next master
+    transaction.
+ */
+typedef void (*i2c_master_done_handler_t)(i2c_instance_t *instance, i2c_status_t status);
+
 
 /*-------------------------------------------------------------------------*//**
   i2c_instance_t
@@ -599,6 +624,8 @@ struct i2c_instance
     /* Master Status */
     volatile i2c_status_t master_status;
     uint32_t master_timeout_ms;
+    uint64_t master_deadline;
+    i2c_master_done_handler_t master_done_handler;
 
     /* Slave TX INFO */
     const uint8_t * slave_tx_buffer;
@@ -864,6 +891,40 @@ void I2C_isr
     i2c_instance_t * this_i2c
 );
 
+/*------------------------------------------------------------------------------
+  CoreI2C PLIC interrupt handler.
+  ------------------------------------------------------------------------------
+    The function I2C_handle_irq() runs I2C_isr() for a CoreI2C instance from its
+    External_N_IRQHandler() and returns what the handler must return. The
+    driver masks the instance's own PLIC source, rather than all interrupts,
+    around the data it shares with I2C_isr(), and leaves the source disabled
+    while the bus is held between transactions. A handler can't disable its own
+    PLIC source, so when I2C_isr() asks for that this function returns
+    EXT_IRQ_DISABLE and riscv_hal disables it after completing the interrupt.
+
+    The PLIC source of each instance is found from its base address in
+    i2c_interrupt.c, which must be kept in line with the hardware design.
+  ------------------------------------------------------------------------------
+    @param this_i2c:
+    The this_i2c parameter is a pointer to the i2c_instance_t data structure
+    holding all data related to a specific CoreI2C channel.
+
+    @return
+    EXT_IRQ_KEEP_ENABLED or EXT_IRQ_DISABLE.
+
+    Example:
+    @code
+    uint8_t External_5_IRQHandler( void )
+    {
+        return I2C_handle_irq( &g_i2c_inst );
+    }
+    @endcode
+ */
+uint8_t I2C_handle_irq
+(
+    i2c_instance_t * this_i2c
+);
+
 /*******************************************************************************
  *******************************************************************************
  * 
@@ -1131,7 +1192,11 @@ void I2C_write_read
 /*-------------------------------------------------------------------------*//**
   I2C status
   ------------------------------------------------------------------------------
-  This function indicates the current state of a CoreI2C channel.
+  This function indicates the current state of a CoreI2C channel. It also
+  checks the time out delay started by I2C_set_timeout(): once its deadline
+  has passed, a transaction still in progress is aborted and I2C_TIMED_OUT is
+  returned, so polling this function is enough to time out transactions that
+  are not waited for with I2C_wait_complete().
   ------------------------------------------------------------------------------
   @param this_i2c:
     The this_i2c parameter is a pointer to the i2c_instance_t data structure
@@ -1189,9 +1254,11 @@ i2c_status_t I2C_get_status
     The timeout_ms parameter specified the delay within which the current I2C 
     transaction is expected to complete. The time out delay is given in 
     milliseconds. I2C_wait_complete() will return I2C_TIMED_OUT if the current
-    transaction has not completed after the time out delay has expired. This
-    parameter can be set to I2C_NO_TIMEOUT to indicate that I2C_wait_complete()
-    must not time out.
+    transaction has not completed after the time out delay has expired, and
+    the CoreI2C is reset to abort the transaction. The delay is measured
+    against MTIME while waiting, so I2C_system_tick() does not need to be
+    called. This parameter can be set to I2C_NO_TIMEOUT to indicate that
+    I2C_wait_complete() must not time out.
   ------------------------------------------------------------------------------
   @return
     The return value indicates the outcome of the last I2C transaction. It can
@@ -1242,18 +1309,17 @@ i2c_status_t I2C_wait_complete
 /*-------------------------------------------------------------------------*//**
   Time out delay expiration.
   ------------------------------------------------------------------------------
-  This function is used to control the expiration of the time out delay
-  specified as a parameter to the I2C_wait_complete() function. It must be
-  called from the interrupt service routine of a periodic interrupt source such
-  as the SysTick timer interrupt. It takes the period of the interrupt
-  source as its ms_since_last_tick parameter and uses it as the time base for
-  the I2C_wait_complete() functions time out delay.
+  This function checks the time out delay started by I2C_set_timeout() against
+  its deadline on the free-running machine timer (MTIME). Once the deadline
+  has passed, a transaction still in progress is aborted by resetting the
+  CoreI2C, its status becomes I2C_TIMED_OUT and the master done handler is
+  called. It can be called from the interrupt service routine of a periodic
+  interrupt source such as the SysTick timer interrupt, and a transaction is
+  then timed out at most one period after its deadline.
   
-  Note: This function does not need to be called if the I2C_wait_complete()
-        function is called with a timeout_ms value of I2C_NO_TIMEOUT.
-  Note: If this function is not called then the I2C_wait_complete() function
-        will behave as if its timeout_ms was specified as I2C_NO_TIMEOUT and it
-        will not time out.
+  Note: This function does not need to be called if the application waits
+        with I2C_wait_complete() or polls I2C_get_status(), which check the
+        deadline themselves.
   Note: If this function is being called from an interrupt handler (e.g SysTick)
         it is important that the calling interrupt have a lower priority than
         the CoreI2C interrupt(s) to ensure any updates to shared data are
@@ -1266,10 +1332,10 @@ i2c_status_t I2C_wait_complete
     one channel is initialized, this data structure holds the information of 
     channel 0 of the instantiated CoreI2C hardware.
   @param ms_since_last_tick:
-    The ms_since_last_tick parameter specifies the number of milliseconds that
-    elapsed since the last call to I2C_system_tick(). This parameter would
-    typically be a constant specifying the interrupt rate of a timer used to
-    generate system ticks.
+    The ms_since_last_tick parameter is the number of milliseconds that
+    elapsed since the last call to I2C_system_tick(). It is kept for
+    compatibility and is no longer used, as the deadline does not depend on
+    the accuracy of the tick.
   ------------------------------------------------------------------------------
   @return
     none.
@@ -1295,6 +1361,87 @@ void I2C_system_tick
     uint32_t ms_since_last_tick
 );
 
+/*-------------------------------------------------------------------------*//**
+  Master transaction time out.
+  ------------------------------------------------------------------------------
+  This function starts the time out delay of the current master transaction
+  without waiting for it to complete. It is the non-blocking counterpart of the
+  timeout_ms parameter of I2C_wait_complete(), for applications that are told
+  of the outcome through I2C_register_master_done_handler() instead. The
+  deadline is taken from MTIME when this function is called and is checked by
+  I2C_get_status(), I2C_wait_complete() and I2C_system_tick(). Call it before
+  starting the transaction, so that the deadline can't be left armed on an
+  instance whose transaction has already ended.
+  ------------------------------------------------------------------------------
+  @param this_i2c:
+    The this_i2c parameter is a pointer to the i2c_instance_t data structure
+    holding all data related to a specific CoreI2C channel.
+  @param timeout_ms:
+    The timeout_ms parameter specifies the delay, in milliseconds, within which
+    the current transaction is expected to complete. I2C_NO_TIMEOUT stops any
+    time out in progress.
+  ------------------------------------------------------------------------------
+  @return
+    none.
+ */
+void I2C_set_timeout
+(
+    i2c_instance_t * this_i2c,
+    uint32_t timeout_ms
+);
+
+/*-------------------------------------------------------------------------*//**
+  Register master completion handler.
+  ------------------------------------------------------------------------------
+  This function registers a function that the driver calls each time a master
+  transaction started by I2C_write(), I2C_read() or I2C_write_read() ends, with
+  the outcome of the transaction. The application can then get on with other
+  work while the transaction is in flight instead of spinning in
+  I2C_wait_complete(). I2C_wait_complete() and I2C_get_status() keep working
+  whether or not a handler is registered.
+  ------------------------------------------------------------------------------
+  @param this_i2c:
+    The this_i2c parameter is a pointer to the i2c_instance_t data structure
+    holding all data related to a specific CoreI2C channel.
+  @param handler:
+    Pointer to the function called when a master transaction ends, or NULL (0)
+    to stop calling one. See i2c_master_done_handler_t for its prototype.
+  ------------------------------------------------------------------------------
+  @return
+    none.
+
+  Example:
+  @code
+    volatile uint8_t g_i2c_done;
+
+    void i2c_done_handler( i2c_instance_t * instance, i2c_status_t status )
+    {
+        g_i2c_done = 1u;
+    }
+
+    void main( void )
+    {
+        I2C_init( &g_i2c_inst, COREI2C_BASE_ADDR, COREI2C_DUMMY_ADDR,
+                  I2C_PCLK_DIV_256 );
+        I2C_register_master_done_handler( &g_i2c_inst, i2c_done_handler );
+
+        I2C_write( &g_i2c_inst, target_slave_addr, tx_buffer, write_length,
+                   I2C_RELEASE_BUS );
+        I2C_set_timeout( &g_i2c_inst, 100u );
+
+        while( !g_i2c_done )
+        {
+            do_other_work();
+        }
+    }
+  @endcode
+ */
+void I2C_register_master_done_handler
+(
+    i2c_instance_t * this_i2c,
+    i2c_master_done_handler_t handler
+);
+
 /*******************************************************************************
  *******************************************************************************
  * 
@@ -1,22 +1,204 @@
 #include "hal.h"
 #include "hal_assert.h"
+#include "hw_platform.h"
+#include "riscv_hal.h"
 #include "core_i2c.h"
 
+/*------------------------------------------------------------------------------
+ * PLIC source of each CoreI2C instance in the design, found from its base
+ * address. in_isr is set while I2C_handle_irq() runs I2C_isr() for the
+ * instance and disable_on_exit records an I2C_disable_irq() made meanwhile:
+ * the PLIC ignores the completion of a source that has been disabled, so a
+ * handler must not disable its own source and asks riscv_hal to do it after
+ * completion instead.
+ */
+typedef struct
+{
+    addr_t base_address;
+    IRQn_Type irq;
+    volatile uint8_t in_isr;
+    volatile uint8_t disable_on_exit;
+} i2c_irq_map_t;
+
+static i2c_irq_map_t g_i2c_irq_map[] =
+{
+    { COREI2C_BASE_ADDR, COREI2C_IRQn, 0u, 0u }
+};
+
+#define I2C_IRQ_MAP_SIZE    ( sizeof(g_i2c_irq_map) / sizeof(g_i2c_irq_map[0]) )
 
 /*------------------------------------------------------------------------------
- * This function must be modified to enable interrupts generated from the
- * CoreI2C instance identified as parameter.
+ * Returns the PLIC source of the CoreI2C instance, or 0 if it is not in
+ * g_i2c_irq_map.
  */
-void I2C_enable_irq( i2c_instance_t * this_i2c )
+static i2c_irq_map_t * get_irq_map( i2c_instance_t * this_i2c )
 {
+    uint32_t inc;
+
+    for(inc = 0u; inc < I2C_IRQ_MAP_SIZE; ++inc)
+    {
+        if(g_i2c_irq_map[inc].base_address == this_i2c->base_address)
+        {
+            return &g_i2c_irq_map[inc];
+        }
+    }
+
     HAL_ASSERT(0)
+    return (i2c_irq_map_t *)0;
+}
+
+/*------------------------------------------------------------------------------
+ * Returns 1 if the PLIC source is enabled.
+ */
+static uint8_t is_irq_enabled( IRQn_Type IRQn )
+{
+    unsigned long hart_id = read_csr(mhartid);
+
+    return (uint8_t)( ( PLIC->TARGET_ENABLES[hart_id].ENABLES[IRQn / 32] >> ( IRQn % 32 ) ) & 1u );
 }
 
 /*------------------------------------------------------------------------------
- * This function must be modified to disable interrupts generated from the
- * CoreI2C instance identified as parameter.
+ * This function enables interrupts generated from the CoreI2C instance
+ * identified as parameter. The PLIC enable register is updated with a
+ * read-modify-write, so interrupts are held off for just that update in case
+ * a handler changes another source at the same time.
+ */
+void I2C_enable_irq( i2c_instance_t * this_i2c )
+{
+    i2c_irq_map_t * map = get_irq_map( this_i2c );
+    psr_t saved_psr;
+
+    if(map != (i2c_irq_map_t *)0)
+    {
+        map->disable_on_exit = 0u;
+
+        saved_psr = HAL_disable_interrupts();
+        PLIC_EnableIRQ(map->irq);
+        HAL_restore_interrupts(saved_psr);
+    }
+}
+
+/*------------------------------------------------------------------------------
+ * This function disables interrupts generated from the CoreI2C instance
+ * identified as parameter. Called from within I2C_isr(), the source is only
+ * disabled once I2C_handle_irq() has returned.
  */
 void I2C_disable_irq( i2c_instance_t * this_i2c )
 {
-    HAL_ASSERT(0)
+    i2c_irq_map_t * map = get_irq_map( this_i2c );
+    psr_t saved_psr;
+
+    if(map != (i2c_irq_map_t *)0)
+    {
+        if(map->in_isr)
+        {
+            map->disable_on_exit = 1u;
+        }
+        else
+        {
+            saved_psr = HAL_disable_interrupts();
+            PLIC_DisableIRQ(map->irq);
+            HAL_restore_interrupts(saved_psr);
+        }
+    }
+}
+
+/*------------------------------------------------------------------------------
+ * This function masks the interrupt of the CoreI2C instance identified as
+ * parameter for a critical section shared with I2C_isr(), leaving every other
+ * interrupt source running. It returns whether the interrupt was enabled, to
+ * be passed to I2C_restore_irq() at the end of the critical section.
+ */
+uint8_t I2C_disable_irq_save( i2c_instance_t * this_i2c )
+{
+    i2c_irq_map_t * map = get_irq_map( this_i2c );
+    uint8_t was_enabled = 0u;
+    psr_t saved_psr;
+
+    if(map != (i2c_irq_map_t *)0)
+    {
+        /* Inside I2C_isr() the instance can't be interrupted by itself. */
+        if(map->in_isr)
+        {
+            return 0u;
+        }
+
+        saved_psr = HAL_disable_interrupts();
+        was_enabled = is_irq_enabled(map->irq);
+        PLIC_DisableIRQ(map->irq);
+        HAL_restore_interrupts(saved_psr);
+    }
+
+    return was_enabled;
+}
+
+/*------------------------------------------------------------------------------
+ * This function ends a critical section started by I2C_disable_irq_save(),
+ * enabling the interrupt again only if it was enabled before.
+ */
+void I2C_restore_irq( i2c_instance_t * this_i2c, uint8_t was_enabled )
+{
+    i2c_irq_map_t * map = get_irq_map( this_i2c );
+    psr_t saved_psr;
+
+    if((map != (i2c_irq_map_t *)0) && was_enabled)
+    {
+        saved_psr = HAL_disable_interrupts();
+        PLIC_EnableIRQ(map->irq);
+        HAL_restore_interrupts(saved_psr);
+    }
+}
+
+/*------------------------------------------------------------------------------
+ * This function returns the free-running time base of the CoreI2C time outs,
+ * the MTIME counter. The two halves are read separately on RV32, so the upper
+ * half is read again to catch a carry between them.
+ */
+uint64_t I2C_get_time( void )
+{
+    volatile uint32_t * mtime = (volatile uint32_t *)&PRCI->MTIME;
+    uint32_t hi;
+    uint32_t lo;
+
+    do {
+        hi = mtime[1];
+        lo = mtime[0];
+    } while(hi != mtime[1]);
+
+    return ( (uint64_t)hi << 32 ) | lo;
+}
+
+/*------------------------------------------------------------------------------
+ * This function converts milliseconds to units of I2C_get_time().
+ */
+uint64_t I2C_ms_to_time( uint32_t ms )
+{
+    return ( (uint64_t)ms * ( SYS_CLK_FREQ / RTC_PRESCALER ) ) / 1000u;
+}
+
+/*------------------------------------------------------------------------------
+ * I2C_handle_irq()
+ * See "core_i2c.h" for details of how to use this function.
+ */
+uint8_t I2C_handle_irq( i2c_instance_t * this_i2c )
+{
+    i2c_irq_map_t * map = get_irq_map( this_i2c );
+    uint8_t disable = EXT_IRQ_KEEP_ENABLED;
+
+    if(map != (i2c_irq_map_t *)0)
+    {
+        map->in_isr = 1u;
+        map->disable_on_exit = 0u;
+
+        I2C_isr( this_i2c );
+
+        map->in_isr = 0u;
+        if(map->disable_on_exit)
+        {
+            map->disable_on_exit = 0u;
+            disable = EXT_IRQ_DISABLE;
+        }
+    }
+
+    return disable;
 }
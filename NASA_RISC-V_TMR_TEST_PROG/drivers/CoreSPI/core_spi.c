@@ -16,9 +16,19 @@
 #define NULL_BLOCK_HANDLER     ( ( spi_block_rx_handler_t ) 0u )
 #define NULL_SLAVE_TX_UPDATE_HANDLER ( ( spi_slave_frame_tx_handler_t ) 0u )
 #define NULL_SLAVE_CMD_HANDLER  NULL_BLOCK_HANDLER
+#define NULL_MASTER_XFER_HANDLER ( ( spi_master_xfer_handler_t ) 0u )
 
 #define SPI_ALL_INTS (0xFFu) /* For clearing all active interrupts */
 
+/*******************************************************************************
+ * Direct register access for SPI_transfer_block_fast(). These compile to a
+ * single load or store instead of a call into hw_reg_access.S.
+ */
+#define SPI_REG8( BASE_ADDR, REG_NAME ) \
+          ( *(volatile uint8_t *)(uintptr_t)( (BASE_ADDR) + (REG_NAME##_REG_OFFSET) ) )
+#define SPI_REG32( BASE_ADDR, REG_NAME ) \
+          ( *(volatile uint32_t *)(uintptr_t)( (BASE_ADDR) + (REG_NAME##_REG_OFFSET) ) )
+
 /*******************************************************************************
  * Possible states for different register bit fields
  */
@@ -41,6 +51,9 @@ enum {
 static void fill_slave_tx_fifo( spi_instance_t * this_spi );
 static void read_slave_rx_fifo( spi_instance_t * this_spi );
 static void recover_from_rx_overflow( const spi_instance_t * this_spi );
+static void service_master_block( spi_instance_t * this_spi );
+static void fill_master_tx_fifo( spi_instance_t * this_spi );
+static void transfer_desc( const spi_instance_t * this_spi, const spi_block_desc_t * desc );
 
 /*******************************************************************************
  * SPI_init()
@@ -480,6 +493,330 @@ void SPI_transfer_block
     }
 }
 
+/***************************************************************************//**
+ * SPI_transfer_duplex()
+ * See "core_spi.h" for details of how to use this function.
+ */
+void SPI_transfer_duplex
+(
+    spi_instance_t * this_spi,
+    const uint8_t * tx_buffer,
+    uint8_t * rx_buffer,
+    uint16_t byte_size
+)
+{
+    uint32_t tx_idx = 0u;          /* Number of frames sent */
+    uint32_t rx_idx = 0u;          /* Number of frames received */
+    uint32_t tx_frame;
+    uint32_t rx_frame;
+
+    HAL_ASSERT( NULL_INSTANCE != this_spi );
+
+    if( NULL_INSTANCE != this_spi )
+    {
+        /* This function is only intended to be used with an SPI master. */
+        if( ( DISABLE != HAL_get_8bit_reg_field(this_spi->base_addr, CTRL1_MASTER ) ) &&
+            /* Check for empty transfer as well */
+            ( 0u != byte_size ) )
+        {
+            /* Flush the receive and transmit FIFOs */
+            HAL_set_8bit_reg(this_spi->base_addr, CMD, (uint32_t)(CMD_TXFIFORST_MASK | CMD_RXFIFORST_MASK ));
+
+            /* Recover from receiver overflow because of previous slave */
+            if( ENABLE == HAL_get_8bit_reg_field(this_spi->base_addr, STATUS_RXOVFLOW) )
+            {
+                 recover_from_rx_overflow( this_spi );
+            }
+
+            /* Disable the Core SPI for a little bit, while we load the TX FIFO */
+            HAL_set_8bit_reg_field( this_spi->base_addr, CTRL1_ENABLE, DISABLE );
+
+            /*
+             * Load what fits in the FIFO before the off, then send a frame every
+             * time one has been received. This keeps no more than fifo_depth
+             * frames in flight so no Rx overflow can happen even if an
+             * interrupt occurs during this function.
+             */
+            while( rx_idx < byte_size )
+            {
+                while( ( tx_idx < byte_size ) &&
+                       ( ( tx_idx - rx_idx ) < this_spi->fifo_depth ) )
+                {
+                    tx_frame = ( 0 != tx_buffer ) ? (uint32_t)tx_buffer[tx_idx] : 0u;
+                    if( tx_idx == ( (uint32_t)byte_size - 1u ) ) /* Last frame is special... */
+                    {
+                        HAL_set_32bit_reg( this_spi->base_addr, TXLAST, tx_frame );
+                    }
+                    else
+                    {
+                        HAL_set_32bit_reg( this_spi->base_addr, TXDATA, tx_frame );
+                    }
+                    ++tx_idx;
+                }
+
+                /* FIFO is all loaded up so enable Core SPI to start transfer */
+                if( DISABLE == HAL_get_8bit_reg_field( this_spi->base_addr, CTRL1_ENABLE ) )
+                {
+                    HAL_set_8bit_reg_field( this_spi->base_addr, CTRL1_ENABLE, ENABLE );
+                }
+
+                while( !HAL_get_8bit_reg_field( this_spi->base_addr, STATUS_RXEMPTY ) )
+                {
+                    rx_frame = HAL_get_32bit_reg( this_spi->base_addr, RXDATA );
+                    if( 0 != rx_buffer )
+                    {
+                        rx_buffer[rx_idx] = (uint8_t)rx_frame;
+                    }
+                    ++rx_idx;
+                }
+            }
+        }
+    }
+}
+
+/***************************************************************************//**
+ * SPI_transfer_block_fast()
+ * See "core_spi.h" for details of how to use this function.
+ */
+void SPI_transfer_block_fast
+(
+    spi_instance_t * this_spi,
+    const uint8_t * cmd_buffer,
+    uint16_t cmd_byte_size,
+    uint8_t * rx_buffer,
+    uint16_t rx_byte_size
+)
+{
+    uint32_t total_size;           /* Total number of frames to transfer */
+    uint32_t tx_idx = 0u;          /* Number of frames sent */
+    uint32_t rx_idx = 0u;          /* Number of frames received */
+    uint32_t depth;
+    uint32_t status;
+    uint32_t rx_frame;
+    addr_t base;
+
+    HAL_ASSERT( NULL_INSTANCE != this_spi );
+
+    if( NULL_INSTANCE != this_spi )
+    {
+        base = this_spi->base_addr;
+        depth = this_spi->fifo_depth;
+        total_size = (uint32_t)cmd_byte_size + (uint32_t)rx_byte_size;
+
+        /* This function is only intended to be used with an SPI master. */
+        if( ( 0u != ( SPI_REG8( base, CTRL1 ) & CTRL1_MASTER_MASK ) ) &&
+            /* Check for empty transfer as well */
+            ( 0u != total_size ) )
+        {
+            /* Flush the receive and transmit FIFOs */
+            SPI_REG8( base, CMD ) = (uint8_t)( CMD_TXFIFORST_MASK | CMD_RXFIFORST_MASK );
+
+            /* Recover from receiver overflow because of previous slave */
+            if( 0u != ( SPI_REG8( base, STATUS ) & STATUS_RXOVFLOW_MASK ) )
+            {
+                 recover_from_rx_overflow( this_spi );
+            }
+
+            /* Disable the Core SPI for a little bit, while we load the TX FIFO */
+            SPI_REG8( base, CTRL1 ) &= (uint8_t)~CTRL1_ENABLE_MASK;
+
+            while( ( tx_idx < ( total_size - 1u ) ) && ( tx_idx < depth ) )
+            {
+                SPI_REG32( base, TXDATA ) = ( tx_idx < cmd_byte_size ) ? (uint32_t)cmd_buffer[tx_idx] : 0u;
+                ++tx_idx;
+            }
+
+            /* If room left to put last frame in before the off, then do it */
+            if( ( tx_idx == ( total_size - 1u ) ) && ( tx_idx < depth ) )
+            {
+                SPI_REG32( base, TXLAST ) = ( tx_idx < cmd_byte_size ) ? (uint32_t)cmd_buffer[tx_idx] : 0u;
+                ++tx_idx;
+            }
+
+            /* FIFO is all loaded up so enable Core SPI to start transfer */
+            SPI_REG8( base, CTRL1 ) |= (uint8_t)CTRL1_ENABLE_MASK;
+
+            /*
+             * One STATUS read per pass decides both directions. Only this
+             * loop reads RXDATA and writes TXDATA, so a cached RXEMPTY of 0
+             * still holds after a frame is sent and a cached TXFULL of 0
+             * still holds after a frame is read. No more than depth frames
+             * are kept in flight so no Rx overflow can happen even if an
+             * interrupt occurs during this function.
+             */
+            while( rx_idx < total_size )
+            {
+                status = SPI_REG8( base, STATUS );
+
+                if( 0u == ( status & STATUS_RXEMPTY_MASK ) )
+                {
+                    rx_frame = SPI_REG32( base, RXDATA );
+                    if( rx_idx >= cmd_byte_size )
+                    {
+                        rx_buffer[rx_idx - cmd_byte_size] = (uint8_t)rx_frame;
+                    }
+                    ++rx_idx;
+                }
+
+                if( ( tx_idx < total_size ) && ( ( tx_idx - rx_idx ) < depth ) &&
+                    ( 0u == ( status & STATUS_TXFULL_MASK ) ) )
+                {
+                    if( tx_idx == ( total_size - 1u ) ) /* Last frame is special... */
+                    {
+                        SPI_REG32( base, TXLAST ) = ( tx_idx < cmd_byte_size ) ? (uint32_t)cmd_buffer[tx_idx] : 0u;
+                    }
+                    else
+                    {
+                        SPI_REG32( base, TXDATA ) = ( tx_idx < cmd_byte_size ) ? (uint32_t)cmd_buffer[tx_idx] : 0u;
+                    }
+                    ++tx_idx;
+                }
+            }
+        }
+    }
+}
+
+/***************************************************************************//**
+ * SPI_transfer_block_async()
+ * See "core_spi.h" for details of how to use this function.
+ */
+uint8_t SPI_transfer_block_async
+(
+    spi_instance_t * this_spi,
+    const uint8_t * cmd_buffer,
+    uint16_t cmd_byte_size,
+    uint8_t * rx_buffer,
+    uint16_t rx_byte_size,
+    spi_master_xfer_handler_t xfer_handler
+)
+{
+    uint8_t started = 0u;
+
+    HAL_ASSERT( NULL_INSTANCE != this_spi );
+
+    if( NULL_INSTANCE != this_spi )
+    {
+        HAL_ASSERT( 0u == this_spi->master_xfer_busy );
+
+        /* This function is only intended to be used with an SPI master. */
+        if( ( DISABLE != HAL_get_8bit_reg_field(this_spi->base_addr, CTRL1_MASTER ) ) &&
+            ( 0u == this_spi->master_xfer_busy ) &&
+            /* Check for empty transfer as well */
+            ( 0u != ( (uint32_t)cmd_byte_size + (uint32_t)rx_byte_size ) ) )
+        {
+            this_spi->master_cmd_buffer = cmd_buffer;
+            this_spi->master_cmd_size = cmd_byte_size;
+            this_spi->master_rx_buffer = rx_buffer;
+            this_spi->master_rx_size = rx_byte_size;
+            this_spi->master_tx_idx = 0u;
+            this_spi->master_rx_idx = 0u;
+            this_spi->master_xfer_handler = xfer_handler;
+            this_spi->master_xfer_busy = 1u;
+
+            /* Flush the receive and transmit FIFOs */
+            HAL_set_8bit_reg(this_spi->base_addr, CMD, (uint32_t)(CMD_TXFIFORST_MASK | CMD_RXFIFORST_MASK ));
+
+            /* Recover from receiver overflow because of previous slave */
+            if( ENABLE == HAL_get_8bit_reg_field(this_spi->base_addr, STATUS_RXOVFLOW) )
+            {
+                 recover_from_rx_overflow( this_spi );
+            }
+
+            /* Disable the Core SPI for a little bit, while we load the TX FIFO */
+            HAL_set_8bit_reg_field( this_spi->base_addr, CTRL1_ENABLE, DISABLE );
+            fill_master_tx_fifo( this_spi );
+
+            /* Every received frame now drives the rest of the transfer */
+            HAL_set_8bit_reg_field( this_spi->base_addr, INTCLR_RXDATA, ENABLE );
+            HAL_set_8bit_reg_field( this_spi->base_addr, CTRL2_INTRXDATA, ENABLE );
+
+            /* FIFO is all loaded up so enable Core SPI to start transfer */
+            HAL_set_8bit_reg_field( this_spi->base_addr, CTRL1_ENABLE, ENABLE );
+            started = 1u;
+        }
+    }
+
+    return started;
+}
+
+/***************************************************************************//**
+ * SPI_transfer_queue()
+ * See "core_spi.h" for details of how to use this function.
+ */
+void SPI_transfer_queue
+(
+    spi_instance_t * this_spi,
+    const spi_block_desc_t * desc,
+    uint32_t desc_count
+)
+{
+    uint32_t desc_idx;
+    uint32_t ssel;
+
+    HAL_ASSERT( NULL_INSTANCE != this_spi );
+    HAL_ASSERT( 0u == this_spi->master_xfer_busy );
+
+    if( ( NULL_INSTANCE != this_spi ) && ( 0u == this_spi->master_xfer_busy ) )
+    {
+        /* This function is only intended to be used with an SPI master. */
+        if( DISABLE != HAL_get_8bit_reg_field(this_spi->base_addr, CTRL1_MASTER ) )
+        {
+            /* Flush the receive and transmit FIFOs, once for the whole list */
+            HAL_set_8bit_reg(this_spi->base_addr, CMD, (uint32_t)(CMD_TXFIFORST_MASK | CMD_RXFIFORST_MASK ));
+
+            /* Recover from receiver overflow because of previous slave */
+            if( ENABLE == HAL_get_8bit_reg_field(this_spi->base_addr, STATUS_RXOVFLOW) )
+            {
+                 recover_from_rx_overflow( this_spi );
+            }
+
+            HAL_set_8bit_reg_field( this_spi->base_addr, CTRL1_ENABLE, ENABLE );
+
+            for( desc_idx = 0u; desc_idx < desc_count; ++desc_idx )
+            {
+                HAL_ASSERT( SPI_MAX_NB_OF_SLAVES > desc[desc_idx].slave );
+
+                if( SPI_MAX_NB_OF_SLAVES > desc[desc_idx].slave )
+                {
+                    ssel = HAL_get_8bit_reg( this_spi->base_addr, SSEL );
+                    HAL_set_8bit_reg( this_spi->base_addr, SSEL,
+                                      (uint_fast8_t)( ssel | ((uint32_t)1u << (uint32_t)desc[desc_idx].slave) ) );
+
+                    transfer_desc( this_spi, &desc[desc_idx] );
+
+                    if( 0u == ( desc[desc_idx].flags & SPI_DESC_KEEP_SELECTED ) )
+                    {
+                        ssel = HAL_get_8bit_reg( this_spi->base_addr, SSEL );
+                        HAL_set_8bit_reg( this_spi->base_addr, SSEL,
+                                          (uint_fast8_t)( ssel & ~((uint32_t)1u << (uint32_t)desc[desc_idx].slave) ) );
+                    }
+                }
+            }
+        }
+    }
+}
+
+/***************************************************************************//**
+ * SPI_block_transfer_busy()
+ * See "core_spi.h" for details of how to use this function.
+ */
+uint32_t SPI_block_transfer_busy
+(
+    const spi_instance_t * this_spi
+)
+{
+    uint32_t busy = 0u;
+
+    HAL_ASSERT( NULL_INSTANCE != this_spi );
+
+    if( NULL_INSTANCE != this_spi )
+    {
+        busy = this_spi->master_xfer_busy;
+    }
+
+    return( busy );
+}
+
 /***************************************************************************//**
  * SPI_set_frame_rx_handler()
  * See "core_spi.h" for details of how to use this function.
@@ -837,7 +1174,11 @@ void SPI_isr
              * for critical timing the mode you are using most often should probably be
              * be the first checked.
              */
-            if( SPI_SLAVE_XFER_BLOCK == this_spi->slave_xfer_mode ) /* Block handling mode. */
+            if( 0u != this_spi->master_xfer_busy ) /* Master asynchronous block transfer. */
+            {
+                service_master_block( this_spi );
+            }
+            else if( SPI_SLAVE_XFER_BLOCK == this_spi->slave_xfer_mode ) /* Block handling mode. */
             {
                 while( 0u == HAL_get_8bit_reg_field( this_spi->base_addr, STATUS_RXEMPTY ) )
                 {
@@ -912,7 +1253,14 @@ void SPI_isr
                 HAL_set_8bit_reg( this_spi->base_addr, CMD, CMD_RXFIFORST_MASK );
             }
 
-            HAL_set_8bit_reg_field( this_spi->base_addr, INTCLR_RXDATA, ENABLE );
+            /*
+             * A master block transfer clears the interrupt itself before
+             * draining the FIFO, so that the last frame cannot be missed.
+             */
+            if( 0u == this_spi->master_xfer_busy )
+            {
+                HAL_set_8bit_reg_field( this_spi->base_addr, INTCLR_RXDATA, ENABLE );
+            }
         }
 
         /* Handle transmit. */
@@ -952,6 +1300,7 @@ void SPI_isr
         /* Handle receive overflow. */
         if( ENABLE == HAL_get_8bit_reg_field(this_spi->base_addr, INTMASK_RXOVERFLOW))
         {
+            ++this_spi->rx_overflow_count;
             HAL_set_8bit_reg(this_spi->base_addr, CMD, CMD_RXFIFORST_MASK);
             HAL_set_8bit_reg_field(this_spi->base_addr, INTCLR_RXOVERFLOW, ENABLE);
         }
@@ -1105,6 +1454,156 @@ static void read_slave_rx_fifo
     }
 }
 
+/***************************************************************************//**
+ * Continue a master asynchronous block transfer from the RX data interrupt.
+ * Received frames that line up with command bytes are discarded, the rest are
+ * stored in the receive buffer. The transfer completes when the frame sent
+ * with TXLAST has come back. The RX data interrupt is cleared before the FIFO
+ * is drained so a frame arriving afterwards raises it again.
+ */
+static void service_master_block
+(
+    spi_instance_t * this_spi
+)
+{
+    uint32_t rx_frame;
+    uint32_t transfer_size = this_spi->master_cmd_size + this_spi->master_rx_size;
+
+    HAL_set_8bit_reg_field( this_spi->base_addr, INTCLR_RXDATA, ENABLE );
+    while( !HAL_get_8bit_reg_field( this_spi->base_addr, STATUS_RXEMPTY ) )
+    {
+        rx_frame = HAL_get_32bit_reg( this_spi->base_addr, RXDATA );
+        if( ( this_spi->master_rx_idx >= this_spi->master_cmd_size ) &&
+            ( this_spi->master_rx_idx < transfer_size ) )
+        {
+            this_spi->master_rx_buffer[this_spi->master_rx_idx - this_spi->master_cmd_size] = (uint8_t)rx_frame;
+        }
+        ++this_spi->master_rx_idx;
+    }
+
+    if( this_spi->master_rx_idx >= transfer_size )
+    {
+        HAL_set_8bit_reg_field( this_spi->base_addr, CTRL2_INTRXDATA, DISABLE );
+        this_spi->master_xfer_busy = 0u;
+        if( NULL_MASTER_XFER_HANDLER != this_spi->master_xfer_handler )
+        {
+            this_spi->master_xfer_handler( this_spi, this_spi->master_rx_size );
+        }
+    }
+    else
+    {
+        fill_master_tx_fifo( this_spi );
+    }
+}
+
+/***************************************************************************//**
+ * Fill the transmit FIFO for a master asynchronous block transfer. The number
+ * of frames sent but not yet received is kept within the FIFO depth so that
+ * the RX FIFO cannot overflow. The last frame is written to TXLAST to trigger
+ * the slave deselect in case the SPS option is in place.
+ */
+static void fill_master_tx_fifo
+(
+    spi_instance_t * this_spi
+)
+{
+    uint32_t tx_frame;
+    uint32_t transfer_size = this_spi->master_cmd_size + this_spi->master_rx_size;
+
+    while( ( this_spi->master_tx_idx < transfer_size ) &&
+           ( ( this_spi->master_tx_idx - this_spi->master_rx_idx ) < this_spi->fifo_depth ) )
+    {
+        if( this_spi->master_tx_idx < this_spi->master_cmd_size )
+        {
+            /* Push out valid data */
+            tx_frame = (uint32_t)this_spi->master_cmd_buffer[this_spi->master_tx_idx];
+        }
+        else
+        {
+            /* Push out 0s to get data back from slave */
+            tx_frame = 0u;
+        }
+
+        if( this_spi->master_tx_idx == ( transfer_size - 1u ) )
+        {
+            HAL_set_32bit_reg( this_spi->base_addr, TXLAST, tx_frame );
+        }
+        else
+        {
+            HAL_set_32bit_reg( this_spi->base_addr, TXDATA, tx_frame );
+        }
+        ++this_spi->master_tx_idx;
+    }
+}
+
+/***************************************************************************//**
+ * Run the frames of one SPI_transfer_queue() descriptor. The CoreSPI is
+ * already enabled and its FIFOs are empty, so frames go out as soon as they
+ * are written. No more than fifo_depth frames are kept in flight and the
+ * function only returns once every frame has been received, leaving both FIFOs
+ * empty for the next descriptor. Received frames are stored from the end of
+ * the command, or from the first frame with SPI_DESC_FULL_DUPLEX.
+ */
+static void transfer_desc
+(
+    const spi_instance_t * this_spi,
+    const spi_block_desc_t * desc
+)
+{
+    uint32_t transfer_size = (uint32_t)desc->cmd_byte_size + (uint32_t)desc->rx_byte_size;
+    uint32_t rx_offset = desc->cmd_byte_size;  /* Frame stored in rx_buffer[0] */
+    uint32_t tx_idx = 0u;
+    uint32_t rx_idx = 0u;
+    uint32_t tx_frame;
+    uint32_t rx_frame;
+
+    if( 0u != ( desc->flags & SPI_DESC_FULL_DUPLEX ) )
+    {
+        transfer_size = ( desc->cmd_byte_size > desc->rx_byte_size ) ? desc->cmd_byte_size
+                                                                     : desc->rx_byte_size;
+        rx_offset = 0u;
+    }
+
+    while( rx_idx < transfer_size )
+    {
+        while( ( tx_idx < transfer_size ) &&
+               ( ( tx_idx - rx_idx ) < this_spi->fifo_depth ) )
+        {
+            if( tx_idx < desc->cmd_byte_size )
+            {
+                /* Push out valid data */
+                tx_frame = (uint32_t)desc->cmd_buffer[tx_idx];
+            }
+            else
+            {
+                /* Push out 0s to get data back from slave */
+                tx_frame = 0u;
+            }
+
+            if( ( tx_idx == ( transfer_size - 1u ) ) &&
+                ( 0u == ( desc->flags & SPI_DESC_KEEP_SELECTED ) ) )
+            {
+                HAL_set_32bit_reg( this_spi->base_addr, TXLAST, tx_frame );
+            }
+            else
+            {
+                HAL_set_32bit_reg( this_spi->base_addr, TXDATA, tx_frame );
+            }
+            ++tx_idx;
+        }
+
+        while( !HAL_get_8bit_reg_field( this_spi->base_addr, STATUS_RXEMPTY ) )
+        {
+            rx_frame = HAL_get_32bit_reg( this_spi->base_addr, RXDATA );
+            if( ( rx_idx >= rx_offset ) && ( ( rx_idx - rx_offset ) < desc->rx_byte_size ) )
+            {
+                desc->rx_buffer[rx_idx - rx_offset] = (uint8_t)rx_frame;
+            }
+            ++rx_idx;
+        }
+    }
+}
+
 /***************************************************************************//**
  * This function is to recover the CoreSPI from receiver overflow.
  * It temporarily disables the CoreSPI from interacting with external world, flushes
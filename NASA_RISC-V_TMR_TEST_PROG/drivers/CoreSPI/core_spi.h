@@ -299,6 +299,22 @@ typedef void (*spi_frame_rx_handler_t)( uint32_t rx_frame );
  */
 typedef void (*spi_block_rx_handler_t)( uint8_t * rx_buff, uint32_t rx_size );
 
+/***************************************************************************//**
+  This defines the function prototype that must be followed by SPI master
+  transfer completion handler functions. These functions are registered with the
+  SPI driver through the SPI_transfer_block_async() function.
+
+  Declaring and Implementing Master Transfer Completion Handler Functions
+     Master transfer completion handler functions should follow the following
+     prototype:
+         void spi_master_xfer_handler ( spi_instance_t * this_spi, uint32_t rx_size );
+     The handler is called from SPI_isr() once the last frame of the transfer
+     has been received. The this_spi parameter identifies the CoreSPI instance
+     that completed the transfer and the rx_size parameter contains the number
+     of bytes stored in the receive buffer.
+ */
+typedef void (*spi_master_xfer_handler_t)( spi_instance_t * this_spi, uint32_t rx_size );
+
 /***************************************************************************//**
  This enumeration is used to select a specific SPI slave device (0 to 7). It is
  used as a parameter to the SPI_configure_master_mode(), SPI_set_slave_select(),
@@ -328,6 +344,41 @@ typedef enum __spi_sxfer_mode_t
     SPI_SLAVE_XFER_FRAME = 2  /* Single frame transfers */
 } spi_sxfer_mode_t;
 
+/***************************************************************************//**
+  Flags of a spi_block_desc_t:
+
+  SPI_DESC_KEEP_SELECTED
+    Leave the slave selected at the end of the descriptor, so that the next
+    descriptor continues the same chip select sequence. The last frame of the
+    descriptor is written to TXDATA instead of TXLAST.
+ */
+#define SPI_DESC_KEEP_SELECTED  0x01u
+
+/***************************************************************************//**
+  SPI_DESC_FULL_DUPLEX
+    Store the frames received while cmd_buffer is sent instead of discarding
+    them. The descriptor exchanges the larger of cmd_byte_size and rx_byte_size
+    frames: frame n sends cmd_buffer[n], or 0 past cmd_byte_size, and stores
+    the received frame in rx_buffer[n] while n is below rx_byte_size.
+ */
+#define SPI_DESC_FULL_DUPLEX    0x02u
+
+/***************************************************************************//**
+  The spi_block_desc_t type describes one chip select sequence of a list run by
+  SPI_transfer_queue(). Each descriptor has the same meaning as the parameters
+  of a call to SPI_transfer_block() on the given slave, or of a call to
+  SPI_transfer_duplex() with SPI_DESC_FULL_DUPLEX.
+ */
+typedef struct spi_block_desc
+{
+    spi_slave_t slave;          /*!< Slave selected for this descriptor. */
+    const uint8_t * cmd_buffer; /*!< Bytes sent at the start of the sequence. */
+    uint16_t cmd_byte_size;     /*!< Number of bytes in cmd_buffer. */
+    uint8_t * rx_buffer;        /*!< Buffer for the bytes received after the command. */
+    uint16_t rx_byte_size;      /*!< Number of bytes to receive after the command. */
+    uint8_t flags;              /*!< Logical OR of SPI_DESC_* flags, or 0. */
+} spi_block_desc_t;
+
 /***************************************************************************//**
   There is one instance of this structure for each of the core SPIs. Instances
   of this structure are used to identify a specific SPI. A pointer to an
@@ -377,6 +428,18 @@ struct spi_instance{
 
     /* How we are expecting to deal with slave transfers */
     spi_sxfer_mode_t slave_xfer_mode;    /*!< Current slave mode transfer configuration. */
+
+    /* Master asynchronous block transfer state: */
+    const uint8_t * master_cmd_buffer;  /*!< Command bytes sent at the start of the transfer. */
+    uint32_t master_cmd_size;           /*!< Number of command bytes. */
+    uint8_t * master_rx_buffer;         /*!< Buffer for the bytes received after the command. */
+    uint32_t master_rx_size;            /*!< Number of bytes to receive after the command. */
+    uint32_t master_tx_idx;             /*!< Frames written to the TX FIFO so far. */
+    uint32_t master_rx_idx;             /*!< Frames read from the RX FIFO so far. */
+    spi_master_xfer_handler_t master_xfer_handler; /*!< Called by SPI_isr() when the transfer completes. */
+    volatile uint32_t master_xfer_busy; /*!< Non-zero while an asynchronous transfer is in progress. */
+
+    volatile uint32_t rx_overflow_count; /*!< Receive overflows handled by SPI_isr(). */
 };
 
 /*==============================================================================
@@ -684,6 +747,225 @@ void SPI_transfer_block
     uint16_t rx_byte_size
 );
 
+/***************************************************************************//**
+  The SPI_transfer_duplex() function exchanges byte_size frames with the
+  selected slave: frame n sends tx_buffer[n] and the frame received at the
+  same time is stored in rx_buffer[n]. Unlike SPI_transfer_block() nothing
+  received is discarded and no dummy frames are sent, so a slave can be
+  commanded for the next sample while the previous one is read.
+
+  The FIFO handling is the same as SPI_transfer_block(): the TX FIFO is loaded
+  before the CoreSPI is enabled and the rest of the transfer sends a frame for
+  each frame received, never keeping more than fifo_depth frames in flight.
+  The last frame is written to TXLAST.
+
+  @param this_spi
+  The this_spi parameter is a pointer to a spi_instance_t structure identifying
+  the CoreSPI hardware block to operate on.
+
+  @param tx_buffer
+  The tx_buffer parameter is a pointer to the byte_size bytes to send. It can
+  be null (0), in which case 0s are sent.
+
+  @param rx_buffer
+  The rx_buffer parameter is a pointer to the buffer where the byte_size
+  received bytes are stored. It can be null (0), in which case the received
+  bytes are discarded.
+
+  @param byte_size
+  The byte_size parameter specifies the number of frames to exchange.
+
+  @return
+  This function does not return any value.
+
+  Example:
+  @code
+      uint8_t next_channel[2] = { 0x08u, 0x00u };
+      uint8_t last_sample[2];
+
+      SPI_set_slave_select( &g_spi0, SPI_SLAVE_0 );
+      SPI_transfer_duplex( &g_spi0, next_channel, last_sample, 2u );
+      SPI_clear_slave_select( &g_spi0, SPI_SLAVE_0 );
+  @endcode
+ */
+void SPI_transfer_duplex
+(
+    spi_instance_t * this_spi,
+    const uint8_t * tx_buffer,
+    uint8_t * rx_buffer,
+    uint16_t byte_size
+);
+
+/***************************************************************************//**
+  The SPI_transfer_block_fast() function performs the same transfer as
+  SPI_transfer_block() with less CPU time per frame, for callers where the
+  driver rather than the bus limits the throughput.
+
+  The registers are accessed directly with precomputed masks instead of through
+  the out of line HAL_get/set_*_reg() routines, and the transfer runs as a
+  single loop that reads STATUS once per pass and uses that value for both the
+  RXEMPTY and TXFULL decisions. As with SPI_transfer_block(), no more than
+  fifo_depth frames are kept in flight and the last frame is written to TXLAST.
+
+  The parameters are the same as for SPI_transfer_block().
+
+  @return
+  This function does not return any value.
+
+  Example:
+  @code
+      SPI_set_slave_select( &g_spi0, SPI_SLAVE_0 );
+      SPI_transfer_block_fast( &g_spi0, &read_cmd, 1u, rx_buffer, sizeof(rx_buffer) );
+      SPI_clear_slave_select( &g_spi0, SPI_SLAVE_0 );
+  @endcode
+ */
+void SPI_transfer_block_fast
+(
+    spi_instance_t * this_spi,
+    const uint8_t * cmd_buffer,
+    uint16_t cmd_byte_size,
+    uint8_t * rx_buffer,
+    uint16_t rx_byte_size
+);
+
+/***************************************************************************//**
+  The SPI_transfer_block_async() function starts the same transfer as
+  SPI_transfer_block() but returns as soon as the TX FIFO has been loaded. The
+  rest of the transfer is carried out by SPI_isr() on the RX data available
+  interrupt: each interrupt empties the RX FIFO and tops the TX FIFO back up,
+  keeping no more than fifo_depth frames in flight so that the RX FIFO cannot
+  overflow. Once the last frame has been received the interrupt is disabled and
+  the xfer_handler function is called from SPI_isr().
+
+  SPI_isr() must be called from the interrupt handler of the CoreSPI interrupt
+  signal, and that interrupt must be enabled in the interrupt controller. The
+  cmd_buffer and rx_buffer must remain valid until the transfer completes. The
+  slave select is not changed by this function or by SPI_isr(); the caller sets
+  it before the call and can clear it from xfer_handler.
+
+  No other transfer can be started on the same CoreSPI instance until the
+  current one completes. SPI_block_transfer_busy() reports whether a transfer
+  started by this function is still in progress.
+
+  @param this_spi
+  The this_spi parameter is a pointer to a spi_instance_t structure identifying
+  the CoreSPI hardware block to operate on.
+
+  @param cmd_buffer
+  The cmd_buffer parameter is a pointer to the buffer containing the data that
+  will be sent by the master from the beginning of the transfer.
+
+  @param cmd_byte_size
+  The cmd_byte_size parameter specifies the number of bytes contained in
+  cmd_buffer that will be sent.
+
+  @param rx_buffer
+  The rx_buffer parameter is a pointer to the buffer where the data received
+  from the slave after the command has been sent will be stored.
+
+  @param rx_byte_size
+  The rx_byte_size parameter specifies the number of bytes to be received from
+  the slave and stored in the rx_buffer.
+
+  @param xfer_handler
+  The xfer_handler parameter is a pointer to the function called from SPI_isr()
+  when the transfer completes. It can be null (0) if the application polls
+  SPI_block_transfer_busy() instead.
+
+  @return
+  1 if the transfer was started, 0 if it was refused because the CoreSPI is
+  not a master, a transfer is already in progress or both sizes are 0. The
+  xfer_handler is only called for a transfer that was started.
+
+  Example:
+  @code
+      static void read_done( spi_instance_t * this_spi, uint32_t rx_size )
+      {
+          SPI_clear_slave_select( this_spi, SPI_SLAVE_0 );
+      }
+
+      uint8_t cmd[1] = { 0x03 };
+      uint8_t data[64];
+
+      SPI_set_slave_select( &g_spi0, SPI_SLAVE_0 );
+      SPI_transfer_block_async( &g_spi0, cmd, sizeof(cmd), data, sizeof(data),
+                                read_done );
+  @endcode
+ */
+uint8_t SPI_transfer_block_async
+(
+    spi_instance_t * this_spi,
+    const uint8_t * cmd_buffer,
+    uint16_t cmd_byte_size,
+    uint8_t * rx_buffer,
+    uint16_t rx_byte_size,
+    spi_master_xfer_handler_t xfer_handler
+);
+
+/***************************************************************************//**
+  The SPI_transfer_queue() function runs a list of block transfers, each on its
+  own slave, without returning between them. The FIFOs are flushed and the
+  CoreSPI is checked for a receive overflow once for the whole list instead of
+  once per transfer, and the CoreSPI stays enabled throughout, so the only gap
+  between descriptors is the slave select change. Each descriptor selects its
+  slave, sends cmd_byte_size bytes from cmd_buffer, stores rx_byte_size bytes
+  in rx_buffer and then deselects the slave unless SPI_DESC_KEEP_SELECTED is
+  set. Any slave already selected before the call stays selected.
+
+  The transfer is polled in the same way as SPI_transfer_block(), and the slave
+  select is only changed once every frame of the previous descriptor has been
+  received.
+
+  @param this_spi
+  The this_spi parameter is a pointer to a spi_instance_t structure identifying
+  the CoreSPI hardware block to operate on.
+
+  @param desc
+  The desc parameter is a pointer to the first of desc_count descriptors.
+
+  @param desc_count
+  The desc_count parameter specifies the number of descriptors in desc.
+
+  @return
+  This function does not return any value.
+
+  Example:
+  @code
+      uint8_t rdsr = 0x05u;
+      uint8_t status;
+      uint8_t sample[2];
+      spi_block_desc_t poll[2] =
+      {
+          { SPI_SLAVE_0, &rdsr, 1u, &status, 1u, 0u },
+          { SPI_SLAVE_3, 0, 0u, sample, 2u, 0u }
+      };
+
+      SPI_transfer_queue( &g_spi0, poll, 2u );
+  @endcode
+ */
+void SPI_transfer_queue
+(
+    spi_instance_t * this_spi,
+    const spi_block_desc_t * desc,
+    uint32_t desc_count
+);
+
+/***************************************************************************//**
+  The SPI_block_transfer_busy() function reports whether a transfer started by
+  SPI_transfer_block_async() is still in progress.
+
+  @param this_spi
+  The this_spi parameter is a pointer to a spi_instance_t structure identifying
+  the CoreSPI hardware block to operate on.
+
+  @return
+  Non-zero while the transfer is in progress, 0 once it has completed.
+ */
+uint32_t SPI_block_transfer_busy
+(
+    const spi_instance_t * this_spi
+);
+
 /***************************************************************************//**
   The SPI_set_frame_rx_handler() function is used by the SPI slaves to specify
   the receive handler function that will be called by the SPI driver interrupt
@@ -10,9 +10,9 @@ extern "C" {
 
 #define NULL_INSTANCE ( ( UART_instance_t* ) 0 )
 #define NULL_BUFFER   ( ( uint8_t* ) 0 )
+#define NULL_HANDLER  ( ( uart_rx_handler_t ) 0 )
 
 #define MAX_LINE_CONFIG     ( ( uint8_t )( DATA_8_BITS | ODD_PARITY ) )
-#define MAX_BAUD_VALUE      ( ( uint16_t )( 0x1FFF ) )
 #define STATUS_ERROR_MASK   ( ( uint8_t )( STATUS_PARITYERR_MASK | \
                                            STATUS_OVERFLOW_MASK  | \
                                            STATUS_FRAMERR_MASK ) )
@@ -22,6 +22,30 @@ extern "C" {
 
 #define STATUS_ERROR_OFFSET STATUS_PARITYERR_SHIFT 
 
+/*
+ * Characters handled by the receive line discipline.
+ */
+#define RX_CHAR_BACKSPACE   ( (uint8_t) (0x08) )
+#define RX_CHAR_LF          ( (uint8_t) (0x0A) )
+#define RX_CHAR_CR          ( (uint8_t) (0x0D) )
+#define RX_CHAR_DELETE      ( (uint8_t) (0x7F) )
+
+#define IS_LINE_END( c )    ( ( (c) == RX_CHAR_CR ) || ( (c) == RX_CHAR_LF ) )
+
+static void queue_tx_blocking
+(
+    UART_instance_t * this_uart,
+    const uint8_t * tx_buffer,
+    size_t tx_size
+);
+
+static void echo_rx
+(
+    UART_instance_t * this_uart,
+    const uint8_t * echo_buffer,
+    size_t echo_size
+);
+
 /***************************************************************************//**
  * UART_init()
  * See "core_uart_apb.h" for details of how to use this function.
@@ -95,6 +119,55 @@ UART_init
          * Clear status of the UART instance.
          */
         this_uart->status = (uint8_t)0;
+
+        /*
+         * Start with polled transmit until a ring buffer is attached.
+         */
+        this_uart->tx_ring_buffer = NULL_BUFFER;
+        this_uart->tx_ring_size = 0u;
+        this_uart->tx_ring_head = 0u;
+        this_uart->tx_ring_tail = 0u;
+        this_uart->rx_ring_buffer = NULL_BUFFER;
+        this_uart->rx_ring_size = 0u;
+        this_uart->rx_ring_head = 0u;
+        this_uart->rx_ring_tail = 0u;
+        this_uart->rx_lines = 0u;
+        this_uart->rx_options = UART_RX_RAW;
+        this_uart->rx_last_char = 0u;
+        this_uart->rx_handler = NULL_HANDLER;
+    }
+}
+
+/***************************************************************************//**
+ * UART_set_baud_value()
+ * See "core_uart_apb.h" for details of how to use this function.
+ */
+void
+UART_set_baud_value
+(
+    UART_instance_t * this_uart,
+    uint16_t baud_value
+)
+{
+    uint8_t line_config;
+
+    HAL_ASSERT( this_uart != NULL_INSTANCE )
+    HAL_ASSERT( baud_value <= MAX_BAUD_VALUE )
+
+    if( ( this_uart != NULL_INSTANCE ) &&
+        ( baud_value <= MAX_BAUD_VALUE ) )
+    {
+        /*
+         * Keep the line configuration held in the lower 3 bits of CTRL2.
+         */
+        line_config = HAL_get_8bit_reg( this_uart->base_address, CTRL2 ) &
+                                    (uint8_t)(~CTRL2_BAUDVALUE_MASK);
+        HAL_set_8bit_reg( this_uart->base_address, CTRL1,
+                          (uint_fast8_t)(baud_value & BAUDVALUE_LSB ) );
+        HAL_set_8bit_reg( this_uart->base_address, CTRL2,
+                          (uint_fast8_t)line_config |
+                          (uint_fast8_t)((baud_value & BAUDVALUE_MSB) >>
+                                                        BAUDVALUE_SHIFT ) );
     }
 }
 
@@ -119,7 +192,14 @@ UART_send
       
     if( (this_uart != NULL_INSTANCE) &&
         (tx_buffer != NULL_BUFFER)   &&
-        (tx_size > (size_t)0) )
+        (tx_size > (size_t)0) &&
+        (this_uart->tx_ring_buffer != NULL_BUFFER) )
+    {
+        queue_tx_blocking( this_uart, tx_buffer, tx_size );
+    }
+    else if( (this_uart != NULL_INSTANCE) &&
+             (tx_buffer != NULL_BUFFER)   &&
+             (tx_size > (size_t)0) )
     {
         for ( char_idx = (size_t)0; char_idx < tx_size; char_idx++ )
         {
@@ -191,6 +271,8 @@ UART_get_rx
     uint8_t new_status;
     uint8_t rx_full;
     size_t rx_idx = 0u;
+    size_t tail;
+    psr_t saved_psr;
     
     HAL_ASSERT( this_uart != NULL_INSTANCE )
     HAL_ASSERT( rx_buffer != NULL_BUFFER )
@@ -198,7 +280,36 @@ UART_get_rx
       
     if( (this_uart != NULL_INSTANCE) &&
         (rx_buffer != NULL_BUFFER)   &&
-        (buff_size > 0u) )
+        (buff_size > 0u) &&
+        (this_uart->rx_ring_buffer != NULL_BUFFER) )
+    {
+        /*
+         * UART_rx_isr() may erase the newest character on backspace, so the
+         * ring must not change while it is being read.
+         */
+        saved_psr = HAL_disable_interrupts();
+        UART_rx_isr( this_uart );
+        tail = this_uart->rx_ring_tail;
+        while( ( tail != this_uart->rx_ring_head ) && ( rx_idx < buff_size ) )
+        {
+            rx_buffer[rx_idx] = this_uart->rx_ring_buffer[tail];
+            if( IS_LINE_END( rx_buffer[rx_idx] ) )
+            {
+                this_uart->rx_lines--;
+            }
+            rx_idx++;
+            tail++;
+            if( tail == this_uart->rx_ring_size )
+            {
+                tail = 0u;
+            }
+        }
+        this_uart->rx_ring_tail = tail;
+        HAL_restore_interrupts( saved_psr );
+    }
+    else if( (this_uart != NULL_INSTANCE) &&
+             (rx_buffer != NULL_BUFFER)   &&
+             (buff_size > 0u) )
     {
         rx_idx = 0u;
         new_status = HAL_get_8bit_reg( this_uart->base_address, STATUS );
@@ -234,7 +345,17 @@ UART_polled_tx_string
     HAL_ASSERT( this_uart != NULL_INSTANCE )
     HAL_ASSERT( p_sz_string != NULL_BUFFER )
     
-    if( ( this_uart != NULL_INSTANCE ) && ( p_sz_string != NULL_BUFFER ) )
+    if( ( this_uart != NULL_INSTANCE ) && ( p_sz_string != NULL_BUFFER ) &&
+        ( this_uart->tx_ring_buffer != NULL_BUFFER ) )
+    {
+        char_idx = 0U;
+        while( 0U != p_sz_string[char_idx] )
+        {
+            char_idx++;
+        }
+        queue_tx_blocking( this_uart, p_sz_string, (size_t)char_idx );
+    }
+    else if( ( this_uart != NULL_INSTANCE ) && ( p_sz_string != NULL_BUFFER ) )
     {
         char_idx = 0U;
         while( 0U != p_sz_string[char_idx] )
@@ -283,6 +404,530 @@ UART_get_rx_status
     return status;
 }
 
+/***************************************************************************//**
+ * UART_set_tx_ring_buffer()
+ * See "core_uart_apb.h" for details of how to use this function.
+ */
+void
+UART_set_tx_ring_buffer
+(
+    UART_instance_t * this_uart,
+    uint8_t * tx_ring,
+    size_t ring_size
+)
+{
+    psr_t saved_psr;
+
+    HAL_ASSERT( this_uart != NULL_INSTANCE )
+    HAL_ASSERT( ( tx_ring == NULL_BUFFER ) || ( ring_size > 1u ) )
+
+    if( ( this_uart != NULL_INSTANCE ) &&
+        ( ( tx_ring == NULL_BUFFER ) || ( ring_size > 1u ) ) )
+    {
+        /*
+         * The TXRDY handler must not see a half updated ring description.
+         */
+        saved_psr = HAL_disable_interrupts();
+        this_uart->tx_ring_head = 0u;
+        this_uart->tx_ring_tail = 0u;
+        if( tx_ring == NULL_BUFFER )
+        {
+            this_uart->tx_ring_size = 0u;
+        }
+        else
+        {
+            this_uart->tx_ring_size = ring_size;
+        }
+        this_uart->tx_ring_buffer = tx_ring;
+        HAL_restore_interrupts( saved_psr );
+    }
+}
+
+/***************************************************************************//**
+ * UART_queue_tx()
+ * See "core_uart_apb.h" for details of how to use this function.
+ */
+size_t
+UART_queue_tx
+(
+    UART_instance_t * this_uart,
+    const uint8_t * tx_buffer,
+    size_t tx_size
+)
+{
+    size_t head;
+    size_t next;
+    size_t size_queued = 0u;
+
+    HAL_ASSERT( this_uart != NULL_INSTANCE )
+    HAL_ASSERT( tx_buffer != NULL_BUFFER )
+
+    if( (this_uart != NULL_INSTANCE) &&
+        (tx_buffer != NULL_BUFFER)   &&
+        (this_uart->tx_ring_buffer != NULL_BUFFER) )
+    {
+        /*
+         * Only the head index is written here and only the tail index is
+         * written by UART_tx_isr(), so no critical section is needed.
+         */
+        head = this_uart->tx_ring_head;
+        while( size_queued < tx_size )
+        {
+            next = head + 1u;
+            if( next == this_uart->tx_ring_size )
+            {
+                next = 0u;
+            }
+            if( next == this_uart->tx_ring_tail )
+            {
+                break;
+            }
+            this_uart->tx_ring_buffer[head] = tx_buffer[size_queued];
+            head = next;
+            size_queued++;
+        }
+        this_uart->tx_ring_head = head;
+
+        if( size_queued > 0u )
+        {
+            UART_enable_tx_irq( this_uart );
+        }
+    }
+    return size_queued;
+}
+
+/***************************************************************************//**
+ * UART_tx_isr()
+ * See "core_uart_apb.h" for details of how to use this function.
+ */
+size_t
+UART_tx_isr
+(
+    UART_instance_t * this_uart
+)
+{
+    size_t head;
+    size_t tail;
+    uint8_t tx_ready;
+    size_t pending = 0u;
+
+    HAL_ASSERT( this_uart != NULL_INSTANCE )
+
+    if( (this_uart != NULL_INSTANCE) &&
+        (this_uart->tx_ring_buffer != NULL_BUFFER) )
+    {
+        head = this_uart->tx_ring_head;
+        tail = this_uart->tx_ring_tail;
+        tx_ready = HAL_get_8bit_reg( this_uart->base_address, STATUS ) &
+                                                      STATUS_TXRDY_MASK;
+        while( ( tail != head ) && ( tx_ready ) )
+        {
+            HAL_set_8bit_reg( this_uart->base_address, TXDATA,
+                              (uint_fast8_t)this_uart->tx_ring_buffer[tail] );
+            tail++;
+            if( tail == this_uart->tx_ring_size )
+            {
+                tail = 0u;
+            }
+            tx_ready = HAL_get_8bit_reg( this_uart->base_address, STATUS ) &
+                                                          STATUS_TXRDY_MASK;
+        }
+        this_uart->tx_ring_tail = tail;
+
+        /*
+         * Bytes queued while the transmitter was being filled are included.
+         */
+        head = this_uart->tx_ring_head;
+        if( head >= tail )
+        {
+            pending = head - tail;
+        }
+        else
+        {
+            pending = ( this_uart->tx_ring_size - tail ) + head;
+        }
+    }
+    return pending;
+}
+
+/***************************************************************************//**
+ * UART_get_tx_pending()
+ * See "core_uart_apb.h" for details of how to use this function.
+ */
+size_t
+UART_get_tx_pending
+(
+    UART_instance_t * this_uart
+)
+{
+    size_t head;
+    size_t tail;
+    size_t pending = 0u;
+
+    HAL_ASSERT( this_uart != NULL_INSTANCE )
+
+    if( (this_uart != NULL_INSTANCE) &&
+        (this_uart->tx_ring_buffer != NULL_BUFFER) )
+    {
+        head = this_uart->tx_ring_head;
+        tail = this_uart->tx_ring_tail;
+        if( head >= tail )
+        {
+            pending = head - tail;
+        }
+        else
+        {
+            pending = ( this_uart->tx_ring_size - tail ) + head;
+        }
+    }
+    return pending;
+}
+
+/***************************************************************************//**
+ * UART_tx_flush()
+ * See "core_uart_apb.h" for details of how to use this function.
+ */
+void
+UART_tx_flush
+(
+    UART_instance_t * this_uart
+)
+{
+    psr_t saved_psr;
+
+    HAL_ASSERT( this_uart != NULL_INSTANCE )
+
+    if( this_uart != NULL_INSTANCE )
+    {
+        /*
+         * Drain the ring from here as well so that flushing also works while
+         * interrupts are disabled.
+         */
+        while( UART_get_tx_pending( this_uart ) > 0u )
+        {
+            saved_psr = HAL_disable_interrupts();
+            (void)UART_tx_isr( this_uart );
+            HAL_restore_interrupts( saved_psr );
+        }
+    }
+}
+
+/***************************************************************************//**
+ * UART_set_rx_ring_buffer()
+ * See "core_uart_apb.h" for details of how to use this function.
+ */
+void
+UART_set_rx_ring_buffer
+(
+    UART_instance_t * this_uart,
+    uint8_t * rx_ring,
+    size_t ring_size,
+    uint8_t options
+)
+{
+    psr_t saved_psr;
+
+    HAL_ASSERT( this_uart != NULL_INSTANCE )
+    HAL_ASSERT( ( rx_ring == NULL_BUFFER ) || ( ring_size > 1u ) )
+
+    if( ( this_uart != NULL_INSTANCE ) &&
+        ( ( rx_ring == NULL_BUFFER ) || ( ring_size > 1u ) ) )
+    {
+        saved_psr = HAL_disable_interrupts();
+        this_uart->rx_ring_head = 0u;
+        this_uart->rx_ring_tail = 0u;
+        this_uart->rx_lines = 0u;
+        this_uart->rx_last_char = 0u;
+        this_uart->rx_options = options;
+        if( rx_ring == NULL_BUFFER )
+        {
+            this_uart->rx_ring_size = 0u;
+        }
+        else
+        {
+            this_uart->rx_ring_size = ring_size;
+        }
+        this_uart->rx_ring_buffer = rx_ring;
+        HAL_restore_interrupts( saved_psr );
+    }
+}
+
+/***************************************************************************//**
+ * UART_rx_isr()
+ * See "core_uart_apb.h" for details of how to use this function.
+ */
+void
+UART_rx_isr
+(
+    UART_instance_t * this_uart
+)
+{
+    static const uint8_t erase_echo[] = { RX_CHAR_BACKSPACE, (uint8_t)' ',
+                                          RX_CHAR_BACKSPACE };
+    static const uint8_t line_end_echo[] = { RX_CHAR_LF, RX_CHAR_CR };
+    uint8_t new_status;
+    uint8_t rx_full;
+    uint8_t rx_char;
+    size_t head;
+    size_t next;
+    size_t prev;
+
+    HAL_ASSERT( this_uart != NULL_INSTANCE )
+
+    if( (this_uart != NULL_INSTANCE) &&
+        (this_uart->rx_ring_buffer != NULL_BUFFER) )
+    {
+        head = this_uart->rx_ring_head;
+        new_status = HAL_get_8bit_reg( this_uart->base_address, STATUS );
+        this_uart->status |= new_status;
+        rx_full = new_status & STATUS_RXFULL_MASK;
+        while( rx_full )
+        {
+            rx_char = HAL_get_8bit_reg( this_uart->base_address, RXDATA );
+
+            if( ( this_uart->rx_handler != NULL_HANDLER ) &&
+                ( this_uart->rx_handler( this_uart, rx_char ) ) )
+            {
+                /* Consumed by the registered handler. */
+            }
+            else if( ( RX_CHAR_LF == rx_char ) &&
+                     ( RX_CHAR_CR == this_uart->rx_last_char ) &&
+                     ( this_uart->rx_options & UART_RX_LINE_EDIT ) )
+            {
+                /* Second half of a CR LF line end, already counted. */
+            }
+            else if( ( ( RX_CHAR_BACKSPACE == rx_char ) ||
+                       ( RX_CHAR_DELETE == rx_char ) ) &&
+                     ( this_uart->rx_options & UART_RX_LINE_EDIT ) )
+            {
+                if( head != this_uart->rx_ring_tail )
+                {
+                    prev = ( head == 0u ) ? ( this_uart->rx_ring_size - 1u )
+                                          : ( head - 1u );
+                    if( !IS_LINE_END( this_uart->rx_ring_buffer[prev] ) )
+                    {
+                        head = prev;
+                        if( this_uart->rx_options & UART_RX_ECHO )
+                        {
+                            echo_rx( this_uart, erase_echo, sizeof(erase_echo) );
+                        }
+                    }
+                }
+            }
+            else
+            {
+                next = head + 1u;
+                if( next == this_uart->rx_ring_size )
+                {
+                    next = 0u;
+                }
+                prev = ( head == 0u ) ? ( this_uart->rx_ring_size - 1u )
+                                      : ( head - 1u );
+                if( ( next == this_uart->rx_ring_tail ) &&
+                    IS_LINE_END( rx_char ) &&
+                    ( head != this_uart->rx_ring_tail ) &&
+                    !IS_LINE_END( this_uart->rx_ring_buffer[prev] ) )
+                {
+                    /*
+                     * Ring full of a line with no end: the line end replaces
+                     * the newest character, so the line can still be read.
+                     */
+                    this_uart->status |= STATUS_OVERFLOW_MASK;
+                    this_uart->rx_ring_buffer[prev] = rx_char;
+                    this_uart->rx_lines++;
+                    if( this_uart->rx_options & UART_RX_ECHO )
+                    {
+                        echo_rx( this_uart, erase_echo, sizeof(erase_echo) );
+                        echo_rx( this_uart, line_end_echo,
+                                 sizeof(line_end_echo) );
+                    }
+                }
+                else if( next == this_uart->rx_ring_tail )
+                {
+                    /* Ring full: drop the character and flag the loss. */
+                    this_uart->status |= STATUS_OVERFLOW_MASK;
+                }
+                else
+                {
+                    this_uart->rx_ring_buffer[head] = rx_char;
+                    head = next;
+                    if( IS_LINE_END( rx_char ) )
+                    {
+                        this_uart->rx_lines++;
+                    }
+                    if( this_uart->rx_options & UART_RX_ECHO )
+                    {
+                        if( IS_LINE_END( rx_char ) )
+                        {
+                            echo_rx( this_uart, line_end_echo,
+                                     sizeof(line_end_echo) );
+                        }
+                        else
+                        {
+                            echo_rx( this_uart, &rx_char, 1u );
+                        }
+                    }
+                }
+            }
+            this_uart->rx_last_char = rx_char;
+
+            new_status = HAL_get_8bit_reg( this_uart->base_address, STATUS );
+            this_uart->status |= new_status;
+            rx_full = new_status & STATUS_RXFULL_MASK;
+        }
+        this_uart->rx_ring_head = head;
+    }
+}
+
+/***************************************************************************//**
+ * UART_set_rx_handler()
+ * See "core_uart_apb.h" for details of how to use this function.
+ */
+void
+UART_set_rx_handler
+(
+    UART_instance_t * this_uart,
+    uart_rx_handler_t handler
+)
+{
+    HAL_ASSERT( this_uart != NULL_INSTANCE )
+
+    if( this_uart != NULL_INSTANCE )
+    {
+        this_uart->rx_handler = handler;
+    }
+}
+
+/***************************************************************************//**
+ * UART_get_rx_lines()
+ * See "core_uart_apb.h" for details of how to use this function.
+ */
+size_t
+UART_get_rx_lines
+(
+    UART_instance_t * this_uart
+)
+{
+    size_t lines = 0u;
+
+    HAL_ASSERT( this_uart != NULL_INSTANCE )
+
+    if( (this_uart != NULL_INSTANCE) &&
+        (this_uart->rx_ring_buffer != NULL_BUFFER) )
+    {
+        lines = this_uart->rx_lines;
+    }
+    return lines;
+}
+
+/***************************************************************************//**
+ * UART_get_rx_line()
+ * See "core_uart_apb.h" for details of how to use this function.
+ */
+size_t
+UART_get_rx_line
+(
+    UART_instance_t * this_uart,
+    uint8_t * line,
+    size_t buff_size
+)
+{
+    size_t tail;
+    size_t line_idx = 0u;
+    uint8_t rx_char;
+    psr_t saved_psr;
+
+    HAL_ASSERT( this_uart != NULL_INSTANCE )
+    HAL_ASSERT( line != NULL_BUFFER )
+    HAL_ASSERT( buff_size > 0 )
+
+    if( (this_uart != NULL_INSTANCE) &&
+        (line != NULL_BUFFER) &&
+        (buff_size > 0u) &&
+        (this_uart->rx_ring_buffer != NULL_BUFFER) )
+    {
+        saved_psr = HAL_disable_interrupts();
+        if( this_uart->rx_lines > 0u )
+        {
+            tail = this_uart->rx_ring_tail;
+            rx_char = this_uart->rx_ring_buffer[tail];
+            while( !IS_LINE_END( rx_char ) )
+            {
+                if( line_idx < ( buff_size - 1u ) )
+                {
+                    line[line_idx] = rx_char;
+                    line_idx++;
+                }
+                tail++;
+                if( tail == this_uart->rx_ring_size )
+                {
+                    tail = 0u;
+                }
+                rx_char = this_uart->rx_ring_buffer[tail];
+            }
+
+            /* Step over the line end. */
+            tail++;
+            if( tail == this_uart->rx_ring_size )
+            {
+                tail = 0u;
+            }
+            this_uart->rx_ring_tail = tail;
+            this_uart->rx_lines--;
+        }
+        HAL_restore_interrupts( saved_psr );
+        line[line_idx] = 0u;
+    }
+    return line_idx;
+}
+
+/***************************************************************************//**
+ * Write echo characters straight into the transmitter. Echo is skipped while
+ * the transmit ring buffer holds data so that it cannot be interleaved with
+ * queued output, and it is cut short when the transmitter is not ready rather
+ * than stalling the receive interrupt.
+ */
+static void echo_rx
+(
+    UART_instance_t * this_uart,
+    const uint8_t * echo_buffer,
+    size_t echo_size
+)
+{
+    if( this_uart->tx_ring_head == this_uart->tx_ring_tail )
+    {
+        (void)UART_fill_tx_fifo( this_uart, echo_buffer, echo_size );
+    }
+}
+
+/***************************************************************************//**
+ * Copy a buffer into the transmit ring buffer, waiting for room when the ring
+ * buffer is full. The ring buffer is serviced from here while waiting so that
+ * transmit cannot deadlock when called with interrupts disabled.
+ */
+static void queue_tx_blocking
+(
+    UART_instance_t * this_uart,
+    const uint8_t * tx_buffer,
+    size_t tx_size
+)
+{
+    size_t size_queued = 0u;
+    psr_t saved_psr;
+
+    while( size_queued < tx_size )
+    {
+        size_queued += UART_queue_tx( this_uart, &tx_buffer[size_queued],
+                                      tx_size - size_queued );
+        if( size_queued < tx_size )
+        {
+            saved_psr = HAL_disable_interrupts();
+            (void)UART_tx_isr( this_uart );
+            HAL_restore_interrupts( saved_psr );
+        }
+    }
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -78,6 +78,35 @@
   The function UART_get_rx_status() returns the error status of the CoreUARTapb
   receiver. This can be used by applications to take appropriate action in case
   of receiver errors.
+
+  @section tx_ring Interrupt-Driven Transmit
+  A transmit ring buffer can be attached to a UART_instance_t using the
+  UART_set_tx_ring_buffer() function. Data handed to UART_queue_tx() is copied
+  into the ring buffer and the function returns straight away; the ring buffer
+  is drained into the CoreUARTapb transmitter by UART_tx_isr(), which must be
+  called from the interrupt handler of the CoreUARTapb TXRDY signal. While a
+  ring buffer is attached, UART_send() and UART_polled_tx_string() also go
+  through the ring buffer and only wait when it is full.
+  
+  As the CoreUARTapb hardware cannot mask its TXRDY interrupt, the driver calls
+  the UART_enable_tx_irq() function each time new data is queued. This function
+  must be implemented by the application (see uart_interrupt.c) to enable the
+  interrupt controller input connected to TXRDY. The TXRDY interrupt handler
+  should disable that input again once UART_tx_isr() reports that the ring
+  buffer is empty, since TXRDY stays asserted while the transmitter is idle.
+
+  @section rx_ring Interrupt-Driven Receive
+  A receive ring buffer can be attached using the UART_set_rx_ring_buffer()
+  function. UART_rx_isr() must then be called from the interrupt handler of the
+  CoreUARTapb RXRDY signal; it empties the receiver into the ring buffer as
+  each character arrives so that the receiver does not overflow while the
+  application is busy. UART_get_rx() reads from the ring buffer while one is
+  attached.
+  
+  UART_rx_isr() also applies a simple line discipline selected by the options
+  passed to UART_set_rx_ring_buffer(): it counts complete lines, erases the
+  last character of an incomplete line on backspace and can echo what it
+  receives. Complete lines are read with UART_get_rx_line().
 *//*=========================================================================*/
 #ifndef __CORE_UART_APB_H
 #define __CORE_UART_APB_H 1
@@ -101,6 +130,12 @@ extern "C" {
 #define EVEN_PARITY     0x02u
 #define ODD_PARITY      0x06u
 
+/***************************************************************************//**
+ * Largest baud value accepted by UART_init() and UART_set_baud_value(). The
+ * baud value register is 13 bits wide.
+ */
+#define MAX_BAUD_VALUE  ( ( uint16_t )( 0x1FFF ) )
+
 /***************************************************************************//**
  * Error Status definitions:
  */
@@ -110,6 +145,34 @@ extern "C" {
 #define UART_APB_NO_ERROR        0x00u
 #define UART_APB_INVALID_PARAM   0xFFu
 
+/***************************************************************************//**
+ * Receive line discipline options, used with UART_set_rx_ring_buffer():
+ * UART_RX_RAW stores every received character unchanged.
+ * UART_RX_LINE_EDIT makes backspace and delete erase the last character of an
+ * incomplete line instead of being stored, and drops the LF of a CR LF line
+ * end so that it is counted as one line.
+ * UART_RX_ECHO echoes received characters back to the sender. Echo is only
+ * written when the transmitter has room and the transmit ring buffer is empty,
+ * so it never delays or reorders queued output.
+ */
+#define UART_RX_RAW             0x00u
+#define UART_RX_LINE_EDIT       0x01u
+#define UART_RX_ECHO            0x02u
+
+/***************************************************************************//**
+ * uart_rx_handler_t
+ * 
+ * Receive character handler function prototype, registered with
+ * UART_set_rx_handler(). The handler is called from UART_rx_isr() for every
+ * received character before the line discipline is applied. It returns a
+ * non-zero value if it has consumed the character, in which case the character
+ * is neither stored in the receive ring buffer nor echoed. This allows a binary
+ * protocol to share the receiver with the interactive console.
+ */
+struct uart_instance;
+typedef uint8_t (*uart_rx_handler_t)( struct uart_instance * this_uart,
+                                      uint8_t rx_char );
+
 /***************************************************************************//**
  * UART_instance_t
  * 
@@ -119,10 +182,26 @@ extern "C" {
  * identify which UART should perform the requested operation. The 'status' 
  * element in the structure is used to provide sticky status information. 
  */
-typedef struct
+typedef struct uart_instance
 {
     addr_t      base_address;
     uint8_t     status;
+    
+    /* Transmit ring buffer, filled by UART_queue_tx(), drained by UART_tx_isr() */
+    uint8_t *       tx_ring_buffer;
+    size_t          tx_ring_size;
+    volatile size_t tx_ring_head;
+    volatile size_t tx_ring_tail;
+    
+    /* Receive ring buffer, filled by UART_rx_isr(), drained by UART_get_rx() */
+    uint8_t *       rx_ring_buffer;
+    size_t          rx_ring_size;
+    volatile size_t rx_ring_head;
+    volatile size_t rx_ring_tail;
+    volatile size_t rx_lines;
+    uint8_t         rx_options;
+    uint8_t         rx_last_char;
+    uart_rx_handler_t rx_handler;
 } UART_instance_t;
 
 /***************************************************************************//**
@@ -180,6 +259,28 @@ UART_init
     uint8_t line_config
 );
 
+/***************************************************************************//**
+ * The function UART_set_baud_value() changes the baud rate of a UART that has
+ * already been initialized. The line configuration, ring buffers and receive
+ * handler are left as they are.
+ *
+ * Note: a character still being shifted out when the baud value changes is
+ * corrupted. Wait for the transmitter to finish before calling this function.
+ *
+ * @param this_uart   The this_uart parameter is a pointer to a UART_instance_t
+ *                    structure which holds all data regarding this instance of
+ *                    the CoreUARTapb.
+ * @param baud_value  The baud_value parameter is the new baud value, calculated
+ *                    as for UART_init(). It must not exceed MAX_BAUD_VALUE.
+ * @return            This function does not return a value.
+ */
+void
+UART_set_baud_value
+(
+    UART_instance_t * this_uart,
+    uint16_t baud_value
+);
+
 /***************************************************************************//**
  * The function UART_send() is used to transmit data. It transfers the contents
  * of the transmitter data buffer, passed as a function parameter, into the 
@@ -192,6 +293,10 @@ UART_init
  * the function return. It is safe to release or reuse the memory used as the
  * transmit buffer once this function returns.
  *
+ * Note: if a transmit ring buffer has been attached with
+ * UART_set_tx_ring_buffer(), the data is copied into the ring buffer instead and
+ * this function only waits while the ring buffer is full.
+ *
  * @param this_uart     The this_uart parameter is a pointer to a 
  *                      UART_instance_t structure which holds all data regarding 
  *                      this instance of the CoreUARTapbUART.
@@ -284,6 +389,10 @@ UART_fill_tx_fifo
  *          errors or overflow errors. When FIFO mode is enabled, the driver 
  *          accumulates a sticky record of overflow errors only; in this case 
  *          interrupts must be used to handle parity errors or framing errors.
+ * Note:    If a receive ring buffer has been attached with
+ *          UART_set_rx_ring_buffer(), the data is read from the ring buffer.
+ *          Any characters still held by the receiver are moved into the ring
+ *          buffer first, so this function also works with interrupts disabled.
  *
  * @param this_uart     The this_uart parameter is a pointer to a UART_instance_t 
  *                      structure which holds all data regarding this instance of 
@@ -325,6 +434,9 @@ UART_get_rx
  *          has been received at the other end by the time this function 
  *          returns. The actual transmission over the serial connection will
  *          still be taking place at the time of the function return.
+ * Note:    If a transmit ring buffer has been attached with
+ *          UART_set_tx_ring_buffer(), the string is copied into the ring buffer
+ *          instead and this function only waits while the ring buffer is full.
  *
  * @param this_uart     The this_uart parameter is a pointer to a 
  *                      UART_instance_t structure which holds
@@ -400,6 +512,303 @@ UART_get_rx_status
     UART_instance_t * this_uart
 );
 
+/***************************************************************************//**
+ * The function UART_set_tx_ring_buffer() attaches a transmit ring buffer to a
+ * CoreUARTapb instance, switching its transmit functions to interrupt-driven
+ * operation. Passing a NULL buffer detaches the ring buffer and returns the
+ * instance to polled transmit. Any data still held in a previously attached
+ * ring buffer is discarded, so UART_tx_flush() should be called first.
+ *
+ * Note:    UART_init() detaches any ring buffer, so this function must be
+ *          called after UART_init().
+ *
+ * @param this_uart     The this_uart parameter is a pointer to a UART_instance_t
+ *                      structure which holds all data regarding this instance of
+ *                      the UART.
+ * @param tx_ring       The tx_ring parameter is a pointer to the memory used to
+ *                      hold data waiting to be transmitted. It must remain valid
+ *                      for as long as it is attached to the instance.
+ * @param ring_size     The ring_size parameter is the size in bytes of tx_ring.
+ *                      One byte of the ring buffer is kept free to tell a full
+ *                      ring from an empty one.
+ * @return              This function does not return a value.
+ *
+ * Example:
+ * @code
+ *   static uint8_t g_tx_ring[512];
+ *
+ *   UART_init(&g_uart, COREUARTAPB0_BASE_ADDR, BAUD_VALUE_115200,
+ *             (DATA_8_BITS | NO_PARITY));
+ *   UART_set_tx_ring_buffer(&g_uart, g_tx_ring, sizeof(g_tx_ring));
+ * @endcode
+ */
+void
+UART_set_tx_ring_buffer
+(
+    UART_instance_t * this_uart,
+    uint8_t * tx_ring,
+    size_t ring_size
+);
+
+/***************************************************************************//**
+ * The function UART_queue_tx() copies as much of the data passed as parameter
+ * as will fit into the transmit ring buffer, enables the TXRDY interrupt through
+ * UART_enable_tx_irq() and returns without waiting for the data to be sent.
+ *
+ * @param this_uart     The this_uart parameter is a pointer to a UART_instance_t
+ *                      structure which holds all data regarding this instance of
+ *                      the UART.
+ * @param tx_buffer     The tx_buffer parameter is a pointer to a buffer 
+ *                      containing the data to be transmitted.
+ * @param tx_size       The tx_size parameter is the size in bytes, of the data 
+ *                      to be transmitted.
+ * @return              This function returns the number of bytes copied into
+ *                      the ring buffer. This is less than tx_size if the ring
+ *                      buffer is full, and 0 if no ring buffer is attached.
+ *
+ * Example:
+ * @code
+ *   uint8_t msg[] = "Queued message\n\r";
+ *   size_t queued = 0u;
+ *
+ *   while(queued < sizeof(msg) - 1u)
+ *   {
+ *       queued += UART_queue_tx(&g_uart, &msg[queued], sizeof(msg) - 1u - queued);
+ *   }
+ * @endcode
+ */
+size_t
+UART_queue_tx
+(
+    UART_instance_t * this_uart,
+    const uint8_t * tx_buffer,
+    size_t tx_size
+);
+
+/***************************************************************************//**
+ * The function UART_tx_isr() moves data from the transmit ring buffer into the
+ * CoreUARTapb transmitter until either the ring buffer is empty or the
+ * transmitter stops being ready. It must be called from the interrupt handler
+ * of the CoreUARTapb TXRDY signal.
+ *
+ * @param this_uart     The this_uart parameter is a pointer to a UART_instance_t
+ *                      structure which holds all data regarding this instance of
+ *                      the UART.
+ * @return              This function returns the number of bytes still waiting
+ *                      in the ring buffer. The TXRDY interrupt should be disabled
+ *                      when it returns 0.
+ *
+ * Example:
+ * @code
+ *   uint8_t External_1_IRQHandler(void)
+ *   {
+ *       if(0u == UART_tx_isr(&g_uart))
+ *       {
+ *           return EXT_IRQ_DISABLE;
+ *       }
+ *       return EXT_IRQ_KEEP_ENABLED;
+ *   }
+ * @endcode
+ */
+size_t
+UART_tx_isr
+(
+    UART_instance_t * this_uart
+);
+
+/***************************************************************************//**
+ * The function UART_get_tx_pending() returns the number of bytes waiting in the
+ * transmit ring buffer.
+ *
+ * @param this_uart     The this_uart parameter is a pointer to a UART_instance_t
+ *                      structure which holds all data regarding this instance of
+ *                      the UART.
+ * @return              This function returns the number of bytes not yet handed
+ *                      to the CoreUARTapb transmitter.
+ */
+size_t
+UART_get_tx_pending
+(
+    UART_instance_t * this_uart
+);
+
+/***************************************************************************//**
+ * The function UART_tx_flush() waits until the transmit ring buffer is empty.
+ * It returns immediately if no ring buffer is attached. The last bytes may still
+ * be in the CoreUARTapb transmitter when this function returns.
+ *
+ * @param this_uart     The this_uart parameter is a pointer to a UART_instance_t
+ *                      structure which holds all data regarding this instance of
+ *                      the UART.
+ * @return              This function does not return a value.
+ */
+void
+UART_tx_flush
+(
+    UART_instance_t * this_uart
+);
+
+/***************************************************************************//**
+ * The function UART_set_rx_ring_buffer() attaches a receive ring buffer to a
+ * CoreUARTapb instance and selects the line discipline applied by
+ * UART_rx_isr(). Passing a NULL buffer detaches the ring buffer and returns
+ * UART_get_rx() to reading the receiver directly. Any data held in a previously
+ * attached ring buffer is discarded.
+ *
+ * Note:    UART_init() detaches any ring buffer, so this function must be
+ *          called after UART_init().
+ *
+ * @param this_uart     The this_uart parameter is a pointer to a UART_instance_t
+ *                      structure which holds all data regarding this instance of
+ *                      the UART.
+ * @param rx_ring       The rx_ring parameter is a pointer to the memory used to
+ *                      hold received data until it is read by the application.
+ * @param ring_size     The ring_size parameter is the size in bytes of rx_ring.
+ *                      One byte of the ring buffer is kept free to tell a full
+ *                      ring from an empty one.
+ * @param options       The options parameter is UART_RX_RAW or a bitwise OR of
+ *                      UART_RX_LINE_EDIT and UART_RX_ECHO.
+ * @return              This function does not return a value.
+ *
+ * Example:
+ * @code
+ *   static uint8_t g_rx_ring[2048];
+ *
+ *   UART_set_rx_ring_buffer(&g_uart, g_rx_ring, sizeof(g_rx_ring),
+ *                           UART_RX_LINE_EDIT | UART_RX_ECHO);
+ * @endcode
+ */
+void
+UART_set_rx_ring_buffer
+(
+    UART_instance_t * this_uart,
+    uint8_t * rx_ring,
+    size_t ring_size,
+    uint8_t options
+);
+
+/***************************************************************************//**
+ * The function UART_rx_isr() moves every character held by the CoreUARTapb
+ * receiver into the receive ring buffer, applying the line discipline selected
+ * with UART_set_rx_ring_buffer(). It must be called from the interrupt handler
+ * of the CoreUARTapb RXRDY signal. The receiver status is accumulated in the
+ * same way as UART_get_rx() does, so UART_get_rx_status() keeps reporting
+ * receiver errors. A character that arrives while the ring buffer is full is
+ * dropped and reported by UART_get_rx_status() as an overflow error, except
+ * for a line end: it replaces the newest character if that is not a line end
+ * itself, so that a line longer than the ring still ends and
+ * UART_get_rx_lines() does not stay at zero.
+ *
+ * @param this_uart     The this_uart parameter is a pointer to a UART_instance_t
+ *                      structure which holds all data regarding this instance of
+ *                      the UART.
+ * @return              This function does not return a value.
+ *
+ * Example:
+ * @code
+ *   uint8_t External_2_IRQHandler(void)
+ *   {
+ *       UART_rx_isr(&g_uart);
+ *       return EXT_IRQ_KEEP_ENABLED;
+ *   }
+ * @endcode
+ */
+void
+UART_rx_isr
+(
+    UART_instance_t * this_uart
+);
+
+/***************************************************************************//**
+ * The function UART_set_rx_handler() registers a function called by
+ * UART_rx_isr() for every received character before the line discipline is
+ * applied. Passing a NULL handler removes it. See uart_rx_handler_t.
+ *
+ * @param this_uart     The this_uart parameter is a pointer to a UART_instance_t
+ *                      structure which holds all data regarding this instance of
+ *                      the UART.
+ * @param handler       The handler parameter is a pointer to the receive
+ *                      character handler function.
+ * @return              This function does not return a value.
+ */
+void
+UART_set_rx_handler
+(
+    UART_instance_t * this_uart,
+    uart_rx_handler_t handler
+);
+
+/***************************************************************************//**
+ * The function UART_get_rx_lines() returns the number of complete lines, ended
+ * by a carriage return or line feed, held in the receive ring buffer. A carriage
+ * return followed by a line feed counts as a single line end.
+ *
+ * @param this_uart     The this_uart parameter is a pointer to a UART_instance_t
+ *                      structure which holds all data regarding this instance of
+ *                      the UART.
+ * @return              This function returns the number of complete lines
+ *                      waiting to be read.
+ */
+size_t
+UART_get_rx_lines
+(
+    UART_instance_t * this_uart
+);
+
+/***************************************************************************//**
+ * The function UART_get_rx_line() removes the oldest complete line from the
+ * receive ring buffer and copies it, without its line end, into the buffer
+ * passed as parameter as a NULL terminated string. Characters that do not fit
+ * in the buffer are discarded. Nothing is removed if no complete line is
+ * waiting; UART_get_rx_lines() should be used to tell this case apart from an
+ * empty line.
+ *
+ * @param this_uart     The this_uart parameter is a pointer to a UART_instance_t
+ *                      structure which holds all data regarding this instance of
+ *                      the UART.
+ * @param line          The line parameter is a pointer to the buffer the line
+ *                      is copied into.
+ * @param buff_size     The buff_size parameter is the size of the line buffer in
+ *                      bytes, including room for the NULL terminator.
+ * @return              This function returns the number of characters copied
+ *                      into the line buffer, excluding the NULL terminator.
+ *
+ * Example:
+ * @code
+ *   uint8_t line[64];
+ *
+ *   while(0u == UART_get_rx_lines(&g_uart))
+ *   {
+ *       ;
+ *   }
+ *   UART_get_rx_line(&g_uart, line, sizeof(line));
+ * @endcode
+ */
+size_t
+UART_get_rx_line
+(
+    UART_instance_t * this_uart,
+    uint8_t * line,
+    size_t buff_size
+);
+
+/***************************************************************************//**
+ * The function UART_enable_tx_irq() is called by the driver whenever data is
+ * queued for interrupt-driven transmit. It is not implemented by the driver:
+ * the application must provide it to enable the interrupt controller input
+ * connected to the TXRDY signal of the CoreUARTapb instance passed as parameter.
+ *
+ * @param this_uart     The this_uart parameter is a pointer to a UART_instance_t
+ *                      structure which holds all data regarding this instance of
+ *                      the UART.
+ * @return              This function does not return a value.
+ */
+void
+UART_enable_tx_irq
+(
+    UART_instance_t * this_uart
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,26 @@
+#include "hal.h"
+#include "hal_assert.h"
+#include "hw_platform.h"
+#include "riscv_hal.h"
+#include "core_uart_apb.h"
+
+
+/*------------------------------------------------------------------------------
+ * This function must be modified to enable the TXRDY interrupt of the
+ * CoreUARTapb instance identified as parameter. The PLIC enable register is
+ * updated with a read-modify-write, so interrupts are held off while it is
+ * changed in case a handler disables another source at the same time.
+ */
+void UART_enable_tx_irq( UART_instance_t * this_uart )
+{
+    psr_t saved_psr;
+
+    HAL_ASSERT(this_uart->base_address == COREUARTAPB0_BASE_ADDR)
+
+    if(this_uart->base_address == COREUARTAPB0_BASE_ADDR)
+    {
+        saved_psr = HAL_disable_interrupts();
+        PLIC_EnableIRQ(UART0_TXRDY_IRQn);
+        HAL_restore_interrupts(saved_psr);
+    }
+}
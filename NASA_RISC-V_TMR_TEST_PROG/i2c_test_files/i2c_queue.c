@@ -0,0 +1,117 @@
+/**
+ * @file 	i2c_queue.c
+ * @author	Zac Carico
+ * @date 	Oct 16 2026
+ *
+ * @brief	Function definitions of i2c_queue.h
+ */
+
+#include "i2c_queue.h"
+
+static void i2c_queue_issue(i2c_queue_t *queue);
+static void i2c_queue_xfer_done(i2c_instance_t *instance, i2c_status_t status);
+
+/**
+ * @brief	Starts running a list of transfers
+ *
+ * @details	The queue takes over the completion handler and user data
+ * 			of the CoreI2C instance until it ends. The transfers and
+ * 			their buffers must stay valid until then.
+ *
+ * @param queue		State of the queue, filled in here
+ * @param i2c		CoreI2C instance to run the transfers on
+ * @param xfers		Transfers, run in order
+ * @param count		Number of transfers
+ * @param handler	Called from the interrupt when the queue ends, or NULL
+ * @param timeoutMs	Time allowed for the whole queue, or I2C_NO_TIMEOUT
+ *
+ * @return	1 if the queue was started, 0 if it is empty or the
+ * 			instance is busy
+ */
+uint8_t i2c_queue_start(i2c_queue_t *queue, i2c_instance_t *i2c, const i2c_xfer_t *xfers, uint16_t count,
+						i2c_queue_done_t handler, uint32_t timeoutMs)
+{
+	if(count == 0 || I2C_get_status(i2c) == I2C_IN_PROGRESS)
+		return 0;
+
+	queue->i2c = i2c;
+	queue->xfers = xfers;
+	queue->count = count;
+	queue->completed = 0;
+	queue->status = I2C_IN_PROGRESS;
+	queue->done = 0;
+	queue->handler = handler;
+
+	I2C_set_user_data(i2c, queue);
+	I2C_register_master_done_handler(i2c, i2c_queue_xfer_done);
+
+	// Armed first, so a first transfer that ends at once can't leave it armed
+	I2C_set_timeout(i2c, timeoutMs);
+	i2c_queue_issue(queue);
+
+	return 1;
+}
+
+/**
+ * @brief	Waits for a queue to end
+ *
+ * @param queue	Queue started with "i2c_queue_start()"
+ *
+ * @return	I2C_SUCCESS if every transfer succeeded, otherwise the
+ * 			status of the one that ended the queue
+ */
+i2c_status_t i2c_queue_wait(i2c_queue_t *queue)
+{
+	// Polling the status is what times the queue out
+	while(!queue->done)
+		(void)I2C_get_status(queue->i2c);
+
+	return queue->status;
+}
+
+/**
+ * @brief	Starts the next transfer, holding the bus unless it is the
+ * 			last one
+ */
+static void i2c_queue_issue(i2c_queue_t *queue)
+{
+	const i2c_xfer_t *xfer = &queue->xfers[queue->completed];
+	uint8_t options = (queue->completed + 1u < queue->count) ? I2C_HOLD_BUS : I2C_RELEASE_BUS;
+
+	if(xfer->txSize > 0 && xfer->rxSize > 0)
+		I2C_write_read(queue->i2c, xfer->address, xfer->tx, xfer->txSize, xfer->rx, xfer->rxSize, options);
+	else if(xfer->rxSize > 0)
+		I2C_read(queue->i2c, xfer->address, xfer->rx, xfer->rxSize, options);
+	else
+		I2C_write(queue->i2c, xfer->address, xfer->tx, xfer->txSize, options);
+}
+
+/**
+ * @brief	Master completion handler of the CoreI2C instance while a
+ * 			queue runs. Chains the next transfer or ends the queue.
+ */
+static void i2c_queue_xfer_done(i2c_instance_t *instance, i2c_status_t status)
+{
+	i2c_queue_t *queue = (i2c_queue_t *)I2C_get_user_data(instance);
+
+	if(queue == NULL || queue->done)
+		return;
+
+	if(status == I2C_SUCCESS)
+	{
+		queue->completed++;
+		if(queue->completed < queue->count)
+		{
+			i2c_queue_issue(queue);
+			return;
+		}
+	}
+
+	I2C_register_master_done_handler(instance, NULL);
+	I2C_set_timeout(instance, I2C_NO_TIMEOUT);
+	queue->status = status;
+	queue->done = 1;
+
+	if(queue->handler != NULL)
+		queue->handler(queue);
+}
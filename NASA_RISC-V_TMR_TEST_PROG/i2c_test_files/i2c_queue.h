@@ -0,0 +1,69 @@
+/**
+ * @file 	i2c_queue.h
+ * @author	Zac Carico
+ * @date 	Oct 16 2026
+ *
+ * @brief	Header file containing all the prototypes
+ * 			and declarations for the I2C transaction queue
+ *
+ * @details	A queue is a list of transfers run back to back from the
+ * 			CoreI2C interrupt. Every transfer but the last holds the
+ * 			bus, so the next one starts with a repeated START from the
+ * 			completion handler of the one before, without a STOP or a
+ * 			return to the application in between. A register read is
+ * 			one transfer with both a tx (register pointer) and an rx
+ * 			part, which "I2C_write_read()" already joins with a
+ * 			repeated START.
+ *
+ * 			The first transfer that fails ends the queue. A NACK has
+ * 			the driver send a STOP, so the bus is released.
+ */
+
+#ifndef I2C_QUEUE_H
+#define I2C_QUEUE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "core_i2c.h"
+
+/**
+ * @brief	One transfer of a queue
+ *
+ * @details	With only txSize set it is a write, with only rxSize set a
+ * 			read, and with both a write of tx followed by a read after a
+ * 			repeated START.
+ */
+typedef struct {
+	uint8_t address;		/**< 7 bit slave address */
+	const uint8_t *tx;		/**< Bytes to write, register pointer for a read */
+	uint16_t txSize;
+	uint8_t *rx;			/**< Buffer for the bytes read */
+	uint16_t rxSize;
+} i2c_xfer_t;
+
+typedef struct i2c_queue i2c_queue_t;
+
+/**
+ * @brief	Called from the interrupt when a queue has ended
+ */
+typedef void (*i2c_queue_done_t)(i2c_queue_t *queue);
+
+/**
+ * @brief	State of a queue. Owned by the driver's completion handler
+ * 			until done is set.
+ */
+struct i2c_queue {
+	i2c_instance_t *i2c;
+	const i2c_xfer_t *xfers;
+	uint16_t count;
+	volatile uint16_t completed;	/**< Transfers that succeeded */
+	volatile i2c_status_t status;	/**< I2C_IN_PROGRESS until the queue ends */
+	volatile uint8_t done;
+	i2c_queue_done_t handler;
+};
+
+uint8_t i2c_queue_start(i2c_queue_t *queue, i2c_instance_t *i2c, const i2c_xfer_t *xfers, uint16_t count,
+						i2c_queue_done_t handler, uint32_t timeoutMs);
+i2c_status_t i2c_queue_wait(i2c_queue_t *queue);
+
+#endif /*I2C_QUEUE_H*/
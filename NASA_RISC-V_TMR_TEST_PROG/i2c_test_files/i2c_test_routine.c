@@ -6,6 +6,8 @@
  * @brief	Function definitions of i2c_test_routine.h
  */
 
+#include <stddef.h>
+#include <string.h>
 #include "i2c_test_routine.h"
 #include "hal.h"
 #include "hw_platform.h"
@@ -13,6 +15,53 @@
 #include "riscv_hal.h"
 #include "core_timer.h"
 #include "core_uart_apb.h"
+#include "tlog.h"
+#include "user_handler.h"
+#include "cycle_count.h"
+#include "uart_printf.h"
+#include "i2c_queue.h"
+
+/**
+ * @brief	Addresses of the sensors read by 
+ * 			"compare_single_and_queued_reads()". Assumed; change them 
+ * 			to match what is fitted to the bus.
+ */
+static const uint8_t g_queue_sensor_addrs[I2C_QUEUE_SENSORS] = {
+	SLAVE_SER_ADDR, 0x31, 0x32, 0x33, 0x34
+};
+
+/**
+ * @brief	Set by "i2c_done_handler()" when a callback transaction ends
+ */
+static volatile uint8_t g_i2c_done;
+
+/**
+ * @brief	Outcome of the last callback transaction
+ */
+static volatile i2c_status_t g_i2c_done_status;
+
+static void i2c_done_handler(i2c_instance_t *instance, i2c_status_t status);
+
+/**
+ * @brief	Initializes the CoreI2C instance and its interrupt. Called by 
+ * 			"run_i2c_test()" and by anything else that issues I2C 
+ * 			transactions through g_core_i2c.
+ * 
+ * @details	No system tick is set up: time-outs are deadlines on MTIME, 
+ * 			checked whenever the status is polled or waited for, so the 
+ * 			cycle benchmarks aren't disturbed by a timer interrupt.
+ */
+void i2c_test_init(void)
+{
+	I2C_init(&g_core_i2c, COREI2C_BASE_ADDR, MASTER_SER_ADDR /*not important because we're using it in master mode*/, I2C_PCLK_DIV_256);
+
+	/* CoreI2C Master. From here on the driver masks and unmasks its own 
+	 * source, so its critical sections don't hold off the other interrupts. */
+	PLIC_SetPriority(COREI2C_IRQn, 1);
+	PLIC_EnableIRQ(COREI2C_IRQn);
+	// Enable interrupts in general. 
+	HAL_enable_interrupts();
+}
 
 /**
  * @brief	Main function of i2c_test_routine. Currently initializes an i2c instance 
@@ -27,19 +76,9 @@ int run_i2c_test(void)
 	uint8_t rx_buff[1];
 	uint8_t loop_count;
 
-	// PLIC Initialization
-	PLIC_init();
-	I2C_init(&g_core_i2c, COREI2C_BASE_ADDR, MASTER_SER_ADDR /*not important because we're using it in master mode*/, I2C_PCLK_DIV_256);
-
-	// Initialize the system tick for 10mS operation or 1 tick every 100th of
-	// a second and also make sure it is lower priority than the I2C IRQs.
-	SysTick_Config(SYS_CLK_FREQ / 2);
-
-	/* CoreI2C Master*/
-	PLIC_SetPriority(External_5_IRQn, 1);
-	PLIC_EnableIRQ(External_5_IRQn);
-	// Enable interrupts in general. 
-	HAL_enable_interrupts();
+	// The PLIC is initialized once in main(), calling PLIC_init() again
+	// would disable the console's transmit interrupt.
+	i2c_test_init();
 
 	// Display the initial information about the demo followed by the main
 	// menu.
@@ -78,9 +117,9 @@ int run_i2c_test(void)
 						}
 						else
 						{
-							UART_polled_tx_string(&g_uart, (const uint8_t *)"Data Write Successful and Data is: ");
-							//UART_send(&g_uart, g_slave_rx_buffer, g_tx_length);
-							UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\r");
+							// No slave instance is set up to receive, so show what was sent
+							UART_polled_tx_string(&g_uart, (const uint8_t *)"Data Write Successful and Data is:\n\r");
+							hexdump(g_master_tx_buf, g_tx_length);
 						}
 						UART_polled_tx_string(&g_uart, (const uint8_t*)"------------------------------------------------------------------------------\n\r");
 					}
@@ -192,6 +231,18 @@ int run_i2c_test(void)
 					// press_any_key_to_continue();
 
 					// break;
+				case '5':
+					compare_blocking_and_callback();
+					press_any_key_to_continue();
+					break;
+				case '6':
+					compare_single_and_queued_reads();
+					press_any_key_to_continue();
+					break;
+				case '7':
+					scan_i2c_bus();
+					press_any_key_to_continue();
+					break;
 				case '4':
 					// To Exit from the application
 					UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\rReturn from the Main function \n\r\n\r");
@@ -199,7 +250,7 @@ int run_i2c_test(void)
 
 				default:
 					// To Invalid Entry
-					UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\rEnter A Valid Key: 1, 2, 3 or 4\n\r");
+					UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\rEnter A Valid Key: 1 to 7\n\r");
 					select_mode_i2c();
 					break;
 			 }
@@ -271,6 +322,271 @@ i2c_status_t do_write_read_transaction(uint8_t serial_addr,
 	return status;
 }
 
+/**
+ * @brief	Measures the CPU time a write to SLAVE_SER_ADDR costs when 
+ * 			waited for with "I2C_wait_complete()" and when completion is 
+ * 			reported through a callback
+ * 
+ * @details	Each way runs I2C_COMPARE_ROUNDS writes of I2C_COMPARE_SIZE 
+ * 			bytes. Blocking, the cycles spent spinning in 
+ * 			"I2C_wait_complete()" are lost to everything else. With the 
+ * 			callback, only the cycles spent starting the transaction 
+ * 			are; the main loop counts how many passes of other work it 
+ * 			gets through until the callback has run. The interrupt 
+ * 			handler itself costs the same both ways.
+ */
+void compare_blocking_and_callback(void)
+{
+	uint8_t data[I2C_COMPARE_SIZE];
+	uint32_t spinCycles = 0;
+	uint32_t issueCycles = 0;
+	uint32_t busyCycles = 0;
+	uint32_t workPasses = 0;
+	uint32_t failures = 0;
+	uint32_t start = 0;
+	uint32_t i = 0;
+	i2c_status_t status;
+
+	for(i = 0; i < I2C_COMPARE_SIZE; i++)
+		data[i] = (uint8_t)('A' + i);
+
+	uart_printf("\n\r%u writes of %u bytes to 0x%02X each way\n\r", I2C_COMPARE_ROUNDS, I2C_COMPARE_SIZE,
+				SLAVE_SER_ADDR);
+
+	for(i = 0; i < I2C_COMPARE_ROUNDS; i++)
+	{
+		I2C_write(&g_core_i2c, SLAVE_SER_ADDR, data, I2C_COMPARE_SIZE, I2C_RELEASE_BUS);
+		start = get_cycle_count();
+		status = I2C_wait_complete(&g_core_i2c, DEMO_I2C_TIMEOUT);
+		spinCycles += get_cycle_count() - start;
+		if(status != I2C_SUCCESS)
+			failures++;
+	}
+	uart_printf("Blocking: %u cycles spun per write, %u failed\n\r", spinCycles / I2C_COMPARE_ROUNDS, failures);
+
+	failures = 0;
+	I2C_register_master_done_handler(&g_core_i2c, i2c_done_handler);
+	for(i = 0; i < I2C_COMPARE_ROUNDS; i++)
+	{
+		g_i2c_done = 0;
+		start = get_cycle_count();
+		// Armed first, so a write that ends at once can't leave it armed
+		I2C_set_timeout(&g_core_i2c, DEMO_I2C_TIMEOUT);
+		I2C_write(&g_core_i2c, SLAVE_SER_ADDR, data, I2C_COMPARE_SIZE, I2C_RELEASE_BUS);
+		issueCycles += get_cycle_count() - start;
+
+		// Stands in for the rest of the application, which polls the 
+		// status so that a hung write is still timed out
+		while(!g_i2c_done)
+		{
+			(void)I2C_get_status(&g_core_i2c);
+			workPasses++;
+		}
+		busyCycles += get_cycle_count() - start;
+
+		if(g_i2c_done_status != I2C_SUCCESS)
+			failures++;
+	}
+	I2C_register_master_done_handler(&g_core_i2c, NULL);
+
+	uart_printf("Callback: %u cycles to start each write, %u cycles in flight, "
+				"%u passes of other work per write, %u failed\n\r", issueCycles / I2C_COMPARE_ROUNDS,
+				busyCycles / I2C_COMPARE_ROUNDS, workPasses / I2C_COMPARE_ROUNDS, failures);
+	UART_polled_tx_string(&g_uart, (const uint8_t*)"------------------------------------------------------------------------------\n\r");
+}
+
+/**
+ * @brief	Reads I2C_QUEUE_REGS registers from each of the 
+ * 			I2C_QUEUE_SENSORS sensors one transaction at a time and then 
+ * 			as one queue, and prints how long each took
+ * 
+ * @details	One at a time, each sensor is a register pointer write and 
+ * 			read ended by a STOP, then waited for before the next one 
+ * 			is set up. Queued, the reads follow each other with 
+ * 			repeated STARTs issued from the interrupt and the bus is 
+ * 			only released after the last one. The data read each way 
+ * 			is compared.
+ */
+void compare_single_and_queued_reads(void)
+{
+	static const uint8_t firstReg = I2C_QUEUE_FIRST_REG;
+	uint8_t single[I2C_QUEUE_SENSORS][I2C_QUEUE_REGS];
+	uint8_t queued[I2C_QUEUE_SENSORS][I2C_QUEUE_REGS];
+	i2c_xfer_t xfers[I2C_QUEUE_SENSORS];
+	i2c_queue_t queue;
+	i2c_status_t status;
+	uint32_t singleCycles = 0;
+	uint32_t queuedCycles = 0;
+	uint32_t start = 0;
+	uint32_t failures = 0;
+	uint32_t mismatches = 0;
+	uint32_t i = 0;
+	uint32_t j = 0;
+
+	memset(single, 0, sizeof(single));
+	memset(queued, 0, sizeof(queued));
+
+	start = get_cycle_count();
+	for(i = 0; i < I2C_QUEUE_SENSORS; i++)
+	{
+		status = do_write_read_transaction(g_queue_sensor_addrs[i], (uint8_t *)&firstReg, 1,
+										   single[i], I2C_QUEUE_REGS);
+		if(status != I2C_SUCCESS)
+			failures++;
+	}
+	singleCycles = get_cycle_count() - start;
+
+	for(i = 0; i < I2C_QUEUE_SENSORS; i++)
+	{
+		xfers[i].address = g_queue_sensor_addrs[i];
+		xfers[i].tx = &firstReg;
+		xfers[i].txSize = 1;
+		xfers[i].rx = queued[i];
+		xfers[i].rxSize = I2C_QUEUE_REGS;
+	}
+
+	start = get_cycle_count();
+	if(i2c_queue_start(&queue, &g_core_i2c, xfers, I2C_QUEUE_SENSORS, NULL, DEMO_I2C_TIMEOUT) == 0)
+	{
+		UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\rI2C is busy, queue not started\n\r");
+		return;
+	}
+	status = i2c_queue_wait(&queue);
+	queuedCycles = get_cycle_count() - start;
+
+	for(i = 0; i < I2C_QUEUE_SENSORS; i++)
+	{
+		for(j = 0; j < I2C_QUEUE_REGS; j++)
+		{
+			if(single[i][j] != queued[i][j])
+				mismatches++;
+		}
+	}
+
+	uart_printf("\n\r%u registers from %u sensors\n\r", I2C_QUEUE_SENSORS * I2C_QUEUE_REGS, I2C_QUEUE_SENSORS);
+	uart_printf("One at a time: %u cycles, %u failed\n\r", singleCycles, failures);
+	uart_printf("Queued:        %u cycles, %u of %u done, status %u\n\r", queuedCycles, queue.completed,
+				I2C_QUEUE_SENSORS, status);
+	uart_printf("Registers that differ: %u\n\r", mismatches);
+	for(i = 0; i < I2C_QUEUE_SENSORS; i++)
+	{
+		uart_printf("0x%02X:", g_queue_sensor_addrs[i]);
+		for(j = 0; j < I2C_QUEUE_REGS; j++)
+			uart_printf(" %02X", queued[i][j]);
+		UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\r");
+	}
+	UART_polled_tx_string(&g_uart, (const uint8_t*)"------------------------------------------------------------------------------\n\r");
+}
+
+/**
+ * @brief	Probes every valid 7 bit address and prints a map of the 
+ * 			devices that answered, with the time each took to ACK
+ * 
+ * @details	Each probe is a zero-length write, a START and the address 
+ * 			byte followed by a STOP. An absent address is NACKed and 
+ * 			the interrupt handler ends the probe at once, so a missing 
+ * 			device costs one address byte on the bus rather than the 
+ * 			DEMO_I2C_TIMEOUT. The map has a row per 16 addresses: "--" 
+ * 			for no answer, the address for an ACK and "??" for a probe 
+ * 			that had to be aborted.
+ */
+void scan_i2c_bus(void)
+{
+	static uint32_t latency[I2C_SCAN_LAST_ADDR + 1u];
+	static i2c_status_t status[I2C_SCAN_LAST_ADDR + 1u];
+	uint32_t start = 0;
+	uint32_t scanCycles = 0;
+	uint32_t found = 0;
+	uint32_t addr = 0;
+
+	start = get_cycle_count();
+	for(addr = I2C_SCAN_FIRST_ADDR; addr <= I2C_SCAN_LAST_ADDR; addr++)
+	{
+		status[addr] = probe_i2c_address((uint8_t)addr, &latency[addr]);
+	}
+	scanCycles = get_cycle_count() - start;
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\r     0  1  2  3  4  5  6  7  8  9  A  B  C  D  E  F");
+	for(addr = 0; addr <= 0x7Fu; addr++)
+	{
+		if(addr % 16u == 0)
+			uart_printf("\n\r%02X: ", addr);
+
+		if(addr < I2C_SCAN_FIRST_ADDR || addr > I2C_SCAN_LAST_ADDR)
+			UART_polled_tx_string(&g_uart, (const uint8_t *)"   ");
+		else if(status[addr] == I2C_SUCCESS)
+			uart_printf("%02X ", addr);
+		else if(status[addr] == I2C_FAILED)
+			UART_polled_tx_string(&g_uart, (const uint8_t *)"-- ");
+		else
+			UART_polled_tx_string(&g_uart, (const uint8_t *)"?? ");
+	}
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\r\n\r");
+	for(addr = I2C_SCAN_FIRST_ADDR; addr <= I2C_SCAN_LAST_ADDR; addr++)
+	{
+		if(status[addr] == I2C_SUCCESS)
+		{
+			uart_printf("0x%02X ACK in %u us\n\r", addr, latency[addr] / (SYS_CLK_FREQ / 1000000u));
+			found++;
+		}
+	}
+	uart_printf("%u device(s), %u addresses scanned in %u us\n\r", found,
+				I2C_SCAN_LAST_ADDR - I2C_SCAN_FIRST_ADDR + 1u, scanCycles / (SYS_CLK_FREQ / 1000000u));
+	UART_polled_tx_string(&g_uart, (const uint8_t*)"------------------------------------------------------------------------------\n\r");
+}
+
+/**
+ * @brief	Sends a zero-length write to one address
+ * 
+ * @details	Waits on the status set by the interrupt handler, which 
+ * 			ends the write as soon as the address is ACKed or NACKed. 
+ * 			If neither happens within I2C_SCAN_PROBE_CYCLES, for 
+ * 			example because a device holds SCL low, the controller is 
+ * 			reset so the next probe starts clean.
+ * 
+ * @param serial_addr	7 bit address to probe
+ * @param cycles		Set to the cycles from the START being requested 
+ * 						to the probe ending
+ * 
+ * @return	I2C_SUCCESS if a device ACKed, I2C_FAILED if not, 
+ * 			I2C_TIMED_OUT if the probe was aborted
+ */
+i2c_status_t probe_i2c_address(uint8_t serial_addr, uint32_t *cycles)
+{
+	i2c_status_t status;
+	uint32_t start = get_cycle_count();
+
+	I2C_write(&g_core_i2c, serial_addr, NULL, 0, I2C_RELEASE_BUS);
+	do {
+		status = I2C_get_status(&g_core_i2c);
+		*cycles = get_cycle_count() - start;
+	} while(status == I2C_IN_PROGRESS && *cycles < I2C_SCAN_PROBE_CYCLES);
+
+	if(status == I2C_IN_PROGRESS)
+	{
+		I2C_init(&g_core_i2c, COREI2C_BASE_ADDR, MASTER_SER_ADDR, I2C_PCLK_DIV_256);
+		status = I2C_TIMED_OUT;
+	}
+
+	return status;
+}
+
+/**
+ * @brief	Master completion handler, called from "I2C_isr()" or 
+ * 			"I2C_get_status()" when a transaction started by 
+ * 			"compare_blocking_and_callback()" ends
+ * 
+ * @param instance	The i2c instance
+ * @param status	Outcome of the transaction
+ */
+static void i2c_done_handler(i2c_instance_t *instance, i2c_status_t status)
+{
+	(void)instance;
+	g_i2c_done_status = status;
+	g_i2c_done = 1;
+}
+
 /**
  * @brief	Slave write handler function called as a result of a the I2C slave being the
  * 			target of a write transaction. This function simply displays the date content
@@ -306,17 +622,17 @@ i2c_slave_handler_ret_t slave_write_handler(i2c_instance_t * this_i2c,
  */
 static void display_greeting(void)
 {
-	UART_polled_tx_string(&g_uart, (const uint8_t*)"\n\r******************************************************************************\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t*)"**************************** Core I2C Example ********************************\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t*)"******************************************************************************\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t*)"This example project Demonstrates the use of I2C in Different Modes\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t*)"CoreI2C0 is configured in Master Mode and CoreI2C1 is configured in Slave Mode\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t*)"\n\r------------------------------------------------------------------------------\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t*)"************* I2C Modes supported by this example project are ****************\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t*)"1. MT-SR :- Master Transmit - Slave Receiver Mode (Write To Slave)\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t*)"2. MR-ST :- Master Receive  - Slave transmit Mode (Read 32 bytes From Slave)\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t*)"3. MT-MR :- Master Transmit - Master Receive Mode (Write To + Read From Slave) \n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t*)"------------------------------------------------------------------------------\n\r");
+	TLOG0("\n\r******************************************************************************\n\r"
+	      "**************************** Core I2C Example ********************************\n\r"
+	      "******************************************************************************\n\r"
+	      "This example project Demonstrates the use of I2C in Different Modes\n\r"
+	      "CoreI2C0 is configured in Master Mode and CoreI2C1 is configured in Slave Mode\n\r"
+	      "\n\r------------------------------------------------------------------------------\n\r"
+	      "************* I2C Modes supported by this example project are ****************\n\r"
+	      "1. MT-SR :- Master Transmit - Slave Receiver Mode (Write To Slave)\n\r"
+	      "2. MR-ST :- Master Receive  - Slave transmit Mode (Read 32 bytes From Slave)\n\r"
+	      "3. MT-MR :- Master Transmit - Master Receive Mode (Write To + Read From Slave) \n\r"
+	      "------------------------------------------------------------------------------\n\r");
 }
 
 /**
@@ -324,12 +640,15 @@ static void display_greeting(void)
  */
 static void select_mode_i2c(void)
 {
-	UART_polled_tx_string(&g_uart, (const uint8_t*)"\n\r*********************** Select the I2C Mode to perform ***********************\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t*)"Press Key '1' to perform MT-SR (Master Transmit - Slave Receive)\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t*)"Press Key '2' to perform MR-ST (Master Receive  - Slave transmit)\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t*)"Press Key '3' to perform MT-MR (Master Transmit - Master Receive)\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t*)"Press Key '4' to EXIT from the Application \n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t*)"------------------------------------------------------------------------------\n\r");
+	TLOG0("\n\r*********************** Select the I2C Mode to perform ***********************\n\r"
+	      "Press Key '1' to perform MT-SR (Master Transmit - Slave Receive)\n\r"
+	      "Press Key '2' to perform MR-ST (Master Receive  - Slave transmit)\n\r"
+	      "Press Key '3' to perform MT-MR (Master Transmit - Master Receive)\n\r"
+	      "Press Key '4' to EXIT from the Application \n\r"
+	      "Press Key '5' to compare blocking and callback completion\n\r"
+	      "Press Key '6' to compare single and queued register reads\n\r"
+	      "Press Key '7' to scan the bus for devices\n\r"
+	      "------------------------------------------------------------------------------\n\r");
 }
 
 /**
@@ -352,7 +671,7 @@ uint8_t get_data()
 		rx_size = UART_get_rx(&g_uart, rx_buff, sizeof(rx_buff));
 		if(rx_size > 0)
 		{
-			UART_send(&g_uart, rx_buff, sizeof(rx_buff));
+			// The key is echoed by the UART receive interrupt.
 
 			// Is it to terminate from the loop
 			if(ENTER == rx_buff[0])
@@ -394,21 +713,12 @@ void press_any_key_to_continue(void)
 }
 
 /**
- * @brief	Service the I2C time-out functionality.
- */
-void SysTick_Handler(void)
-{
-	I2C_system_tick(&g_core_i2c, 10);
-	//I2C_system_tick(&g_core_i2c1, 10);
-}
-
-/**
- * @brief	Interrupt handler. Not sure what this does when called though...
+ * @brief	Interrupt handler of g_core_i2c. Runs the driver's state machine 
+ * 			and lets it disable the source while the bus is held.
  */
 uint8_t External_5_IRQHandler(void)
 {
-	I2C_isr(&g_core_i2c);
-	return (EXT_IRQ_KEEP_ENABLED);
+	return I2C_handle_irq(&g_core_i2c);
 }
 
 /**
@@ -44,6 +44,38 @@ i2c_instance_t g_core_i2c;
  */
 #define DEMO_I2C_TIMEOUT 3000u
 
+/**
+ * @brief	Writes timed each way by "compare_blocking_and_callback()"
+ */
+#define I2C_COMPARE_ROUNDS	16u
+
+/**
+ * @brief	Bytes in each write of "compare_blocking_and_callback()"
+ */
+#define I2C_COMPARE_SIZE	8u
+
+/**
+ * @brief	Sensors read by "compare_single_and_queued_reads()", and 
+ * 			the registers read from each one in a single burst from 
+ * 			I2C_QUEUE_FIRST_REG
+ */
+#define I2C_QUEUE_SENSORS	5u
+#define I2C_QUEUE_REGS		4u
+#define I2C_QUEUE_FIRST_REG	0x00u
+
+/**
+ * @brief	7 bit addresses probed by "scan_i2c_bus()". 0x00-0x07 and 
+ * 			0x78-0x7F are reserved by the I2C specification.
+ */
+#define I2C_SCAN_FIRST_ADDR	0x08u
+#define I2C_SCAN_LAST_ADDR	0x77u
+
+/**
+ * @brief	Longest a probe may take before the controller is reset, 
+ * 			1 ms. An absent device is NACKed well within this.
+ */
+#define I2C_SCAN_PROBE_CYCLES	(SYS_CLK_FREQ / 1000u)
+
 /*-----------------------------------------------------------------------------
  * Local functions.
  */
@@ -51,6 +83,10 @@ i2c_slave_handler_ret_t slave_write_handler(i2c_instance_t *, uint8_t *, uint16_
 i2c_status_t do_write_transaction(uint8_t, uint8_t * , uint8_t);
 i2c_status_t do_read_transaction(uint8_t, uint8_t * , uint8_t);
 i2c_status_t do_write_read_transaction(uint8_t , uint8_t * , uint8_t , uint8_t * , uint8_t);
+void compare_blocking_and_callback(void);
+void compare_single_and_queued_reads(void);
+void scan_i2c_bus(void);
+i2c_status_t probe_i2c_address(uint8_t serial_addr, uint32_t *cycles);
 static void display_greeting(void);
 static void select_mode_i2c(void);
 uint8_t get_data(void);
@@ -75,6 +111,7 @@ static uint8_t g_tx_length=0x00;
 extern UART_instance_t g_uart;
 
 
+void i2c_test_init(void);
 int run_i2c_test(void);
 
 
@@ -0,0 +1,82 @@
+/**
+ * @file 	tlog.c
+ * @author	Zac Carico
+ * @date 	Oct 16 2026
+ *
+ * @brief	Function definitions of tlog.h
+ */
+
+#include "tlog.h"
+#include "cmd_protocol.h"
+#include "uart_printf.h"
+
+/** @brief Largest record message: tag, ID and every argument */
+#define TLOG_MAX_MESSAGE	(1u + 2u + (TLOG_MAX_ARGS * 4u))
+
+/** @brief Largest record frame: both delimiters and the COBS code byte */
+#define TLOG_MAX_FRAME		(TLOG_MAX_MESSAGE + 3u)
+
+/**
+ * @brief	Sends a tokenized record. Called by the TLOG macros when
+ * 			USE_TLOG is 1.
+ *
+ * @param id	Offset of the format string in the ".tlog_fmt" section
+ * @param nargs	Number of arguments used by the format string
+ * @param a0	First argument, ignored if nargs < 1
+ * @param a1	Second argument, ignored if nargs < 2
+ * @param a2	Third argument, ignored if nargs < 3
+ * @param a3	Fourth argument, ignored if nargs < 4
+ */
+void tlog_write(uint16_t id, uint8_t nargs, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3)
+{
+	uint8_t message[TLOG_MAX_MESSAGE];
+	uint8_t frame[TLOG_MAX_FRAME];
+	uint32_t args[TLOG_MAX_ARGS];
+	uint16_t length = 0;
+	uint16_t frameLength;
+	uint8_t i;
+
+	args[0] = a0;
+	args[1] = a1;
+	args[2] = a2;
+	args[3] = a3;
+
+	if(nargs > TLOG_MAX_ARGS)
+		nargs = TLOG_MAX_ARGS;
+
+	message[length++] = TLOG_FRAME_TAG;
+	message[length++] = (uint8_t)id;
+	message[length++] = (uint8_t)(id >> 8);
+	for(i = 0; i < nargs; i++)
+	{
+		message[length++] = (uint8_t)args[i];
+		message[length++] = (uint8_t)(args[i] >> 8);
+		message[length++] = (uint8_t)(args[i] >> 16);
+		message[length++] = (uint8_t)(args[i] >> 24);
+	}
+
+	frame[0] = CMD_FRAME_DELIMITER;
+	frameLength = cobs_encode(message, length, &frame[1]) + 1;
+	frame[frameLength] = CMD_FRAME_DELIMITER;
+	frameLength++;
+
+	UART_send(&g_uart, frame, frameLength);
+}
+
+/**
+ * @brief	Formats a record on the target and sends it as text. Called
+ * 			by the TLOG macros when USE_TLOG is 0.
+ *
+ * @param fmt	Format string
+ * @param nargs	Number of arguments used by the format string
+ * @param a0	First argument, ignored if nargs < 1
+ * @param a1	Second argument, ignored if nargs < 2
+ * @param a2	Third argument, ignored if nargs < 3
+ * @param a3	Fourth argument, ignored if nargs < 4
+ */
+void tlog_print(const char *fmt, uint8_t nargs, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3)
+{
+	// Arguments the format string doesn't use are never read
+	(void)nargs;
+	uart_printf(fmt, a0, a1, a2, a3);
+}
@@ -0,0 +1,92 @@
+/**
+ * @file 	tlog.h
+ * @author	Zac Carico
+ * @date 	Oct 16 2026
+ *
+ * @brief	Header file containing all the prototypes and declarations
+ * 			for tokenized console logging
+ *
+ * @details	With USE_TLOG set to 1 the format string of every TLOG call
+ * 			is placed in the ".tlog_fmt" section. The linker scripts mark
+ * 			that section as not loaded, so the strings stay in the .elf
+ * 			but take no space in the 64 KB RAM image. The offset of a
+ * 			string in the section is its ID, and the firmware only sends
+ * 			the ID and the binary arguments.
+ *
+ * 			Each record is sent like a command protocol frame: a 0x00
+ * 			delimiter, the COBS encoded message, then another 0x00. The
+ * 			message (multi-byte values little endian) is:
+ * 			- [TLOG_FRAME_TAG][id u16][arg u32 ...]
+ *
+ * 			tools/tlog_decode.py reads the strings from the .elf and
+ * 			prints the expanded records, and passes console text sent
+ * 			with "UART_polled_tx_string()" through unchanged.
+ *
+ * 			With USE_TLOG set to 0 (the default) the records are
+ * 			formatted on the target by "uart_printf()" and sent as text, 
+ * 			so a plain terminal still works.
+ *
+ * 			Format strings may use %d, %u, %x, %X, %c and %%, with an
+ * 			optional '0' flag and width. Every argument is sent as 32 bits.
+ *
+ * @code
+	TLOG0("\tCOMMANDS:\n\r");
+	TLOG2("Read %u bytes from 0x%02x\n\r", length, address);
+ * @endcode
+ */
+
+#ifndef TLOG_H
+#define TLOG_H
+
+#include <stdint.h>
+#include "core_uart_apb.h"
+
+#ifndef USE_TLOG
+/** @brief Set to 1 to send tokenized records instead of text */
+#define USE_TLOG			0
+#endif
+
+/**
+ * @brief	First byte of every record message, after COBS decoding. 
+ * 			Command protocol responses start with their sequence number, 
+ * 			which is kept at or below CMD_SEQ_MAX so it never matches.
+ */
+#define TLOG_FRAME_TAG		0xFEu
+
+/** @brief Most arguments a single record can carry */
+#define TLOG_MAX_ARGS		4u
+
+#if USE_TLOG
+
+/**
+ * @brief	Places the format string in the ".tlog_fmt" section and
+ * 			sends its ID with the arguments
+ */
+#define TLOG_(nargs, fmt, a0, a1, a2, a3)									\
+	do {																	\
+		static const char tlog_fmt_[]										\
+			__attribute__((section(".tlog_fmt"), used)) = fmt;				\
+		tlog_write((uint16_t)(uintptr_t)tlog_fmt_, (nargs),					\
+				   (uint32_t)(a0), (uint32_t)(a1), (uint32_t)(a2), (uint32_t)(a3));	\
+	} while(0)
+
+#else
+
+#define TLOG_(nargs, fmt, a0, a1, a2, a3)									\
+	tlog_print((fmt), (nargs),												\
+			   (uint32_t)(a0), (uint32_t)(a1), (uint32_t)(a2), (uint32_t)(a3))
+
+#endif /*USE_TLOG*/
+
+#define TLOG0(fmt)					TLOG_(0u, fmt, 0, 0, 0, 0)
+#define TLOG1(fmt, a0)				TLOG_(1u, fmt, a0, 0, 0, 0)
+#define TLOG2(fmt, a0, a1)			TLOG_(2u, fmt, a0, a1, 0, 0)
+#define TLOG3(fmt, a0, a1, a2)		TLOG_(3u, fmt, a0, a1, a2, 0)
+#define TLOG4(fmt, a0, a1, a2, a3)	TLOG_(4u, fmt, a0, a1, a2, a3)
+
+extern UART_instance_t g_uart;
+
+void tlog_write(uint16_t id, uint8_t nargs, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3);
+void tlog_print(const char *fmt, uint8_t nargs, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3);
+
+#endif /*TLOG_H*/
@@ -0,0 +1,291 @@
+/**
+ * @file 	uart_printf.c
+ * @author	Zac Carico
+ * @date 	Oct 16 2026
+ *
+ * @brief	Function definitions of uart_printf.h
+ */
+
+#include "uart_printf.h"
+
+/**
+ * @brief	Where "uart_vformat()" is writing its output
+ */
+typedef struct {
+	char *buf;
+	uint16_t size;
+	uint16_t length;
+	uint16_t total;
+	void (*flush)(const char *, uint16_t);
+} format_output_t;
+
+static void put_char(format_output_t *out, char c);
+static void put_padded(format_output_t *out, const char *text, uint16_t length,
+					   uint8_t width, uint8_t leftAlign, char padChar);
+static void send_to_uart(const char *text, uint16_t length);
+
+static const char hex_upper[] = "0123456789ABCDEF";
+static const char hex_lower[] = "0123456789abcdef";
+
+/**
+ * @brief	Formats a message and sends it to g_uart
+ *
+ * @param fmt	Format string, see uart_printf.h for the conversions
+ *
+ * @return	Number of characters sent
+ */
+uint16_t uart_printf(const char *fmt, ...)
+{
+	char buf[UART_PRINTF_BUFFER_SIZE];
+	uint16_t length;
+	va_list args;
+
+	va_start(args, fmt);
+	length = uart_vformat(buf, sizeof(buf), send_to_uart, fmt, args);
+	va_end(args);
+
+	return length;
+}
+
+/**
+ * @brief	Formats a message into a string
+ *
+ * @param buf	Filled with the formatted, null terminated message
+ * @param size	Size of buf. Longer messages are cut short.
+ * @param fmt	Format string, see uart_printf.h for the conversions
+ *
+ * @return	Number of characters written to buf, not counting the '\0'
+ */
+uint16_t uart_snprintf(char *buf, uint16_t size, const char *fmt, ...)
+{
+	uint16_t length;
+	va_list args;
+
+	if(size == 0)
+		return 0;
+
+	va_start(args, fmt);
+	length = uart_vformat(buf, size - 1, 0, fmt, args);
+	va_end(args);
+
+	if(length > size - 1)
+		length = size - 1;
+	buf[length] = '\0';
+
+	return length;
+}
+
+/**
+ * @brief	Formats a message into buf
+ *
+ * @param buf	Buffer the message is formatted into
+ * @param size	Size of buf
+ * @param flush	Called with the contents of buf each time it fills and
+ * 				once at the end. If null, the message is cut short when
+ * 				buf is full.
+ * @param fmt	Format string, see uart_printf.h for the conversions
+ * @param args	Arguments of the conversions
+ *
+ * @return	Number of characters the full message holds
+ */
+uint16_t uart_vformat(char *buf, uint16_t size, void (*flush)(const char *, uint16_t),
+					  const char *fmt, va_list args)
+{
+	format_output_t out;
+	char digits[11];
+
+	out.buf = buf;
+	out.size = size;
+	out.length = 0;
+	out.total = 0;
+	out.flush = flush;
+
+	while(*fmt != '\0')
+	{
+		uint8_t leftAlign = 0;
+		uint8_t width = 0;
+		char padChar = ' ';
+		uint8_t count = 0;
+		uint32_t value;
+
+		if(*fmt != '%')
+		{
+			put_char(&out, *fmt++);
+			continue;
+		}
+		fmt++;
+
+		// Flags
+		while(*fmt == '-' || *fmt == '0')
+		{
+			if(*fmt == '-')
+				leftAlign = 1;
+			else
+				padChar = '0';
+			fmt++;
+		}
+
+		// Width
+		if(*fmt == '*')
+		{
+			width = (uint8_t)va_arg(args, int);
+			fmt++;
+		}
+		while(*fmt >= '0' && *fmt <= '9')
+		{
+			width = (uint8_t)(width * 10 + (*fmt - '0'));
+			fmt++;
+		}
+
+		// Every integer is already 32 bits
+		if(*fmt == 'l')
+			fmt++;
+
+		switch(*fmt)
+		{
+			case 'd':
+			case 'i':
+			{
+				int32_t number = va_arg(args, int32_t);
+				value = (number < 0) ? (0u - (uint32_t)number) : (uint32_t)number;
+				do {
+					digits[sizeof(digits) - 1 - count++] = (char)('0' + value % 10);
+					value /= 10;
+				} while(value != 0);
+
+				if(number < 0)
+				{
+					if(padChar == '0' && !leftAlign)
+					{
+						// The sign goes in front of the zeros
+						put_char(&out, '-');
+						if(width > 0)
+							width--;
+					}
+					else
+					{
+						digits[sizeof(digits) - 1 - count++] = '-';
+					}
+				}
+				put_padded(&out, &digits[sizeof(digits) - count], count, width, leftAlign, padChar);
+				break;
+			}
+			case 'u':
+				value = va_arg(args, uint32_t);
+				do {
+					digits[sizeof(digits) - 1 - count++] = (char)('0' + value % 10);
+					value /= 10;
+				} while(value != 0);
+				put_padded(&out, &digits[sizeof(digits) - count], count, width, leftAlign, padChar);
+				break;
+			case 'x':
+			case 'X':
+			{
+				const char *hex = (*fmt == 'X') ? hex_upper : hex_lower;
+				value = va_arg(args, uint32_t);
+				do {
+					digits[sizeof(digits) - 1 - count++] = hex[value & 0xF];
+					value >>= 4;
+				} while(value != 0);
+				put_padded(&out, &digits[sizeof(digits) - count], count, width, leftAlign, padChar);
+				break;
+			}
+			case 'c':
+				digits[0] = (char)va_arg(args, int);
+				put_padded(&out, digits, 1, width, leftAlign, ' ');
+				break;
+			case 's':
+			{
+				const char *text = va_arg(args, const char *);
+				uint16_t length = 0;
+				if(text == 0)
+					text = "(null)";
+				while(text[length] != '\0')
+					length++;
+				put_padded(&out, text, length, width, leftAlign, ' ');
+				break;
+			}
+			case 'B':
+			{
+				const uint8_t *data = va_arg(args, const uint8_t *);
+				uint32_t length = va_arg(args, uint32_t);
+				uint32_t i;
+				for(i = 0; i < length; i++)
+				{
+					if(i > 0)
+						put_char(&out, ' ');
+					put_char(&out, hex_upper[data[i] >> 4]);
+					put_char(&out, hex_upper[data[i] & 0xF]);
+				}
+				break;
+			}
+			case '%':
+				put_char(&out, '%');
+				break;
+			case '\0':
+				// A lone '%' at the end of the format string
+				continue;
+			default:
+				// Unsupported conversions are printed as written
+				put_char(&out, '%');
+				put_char(&out, *fmt);
+				break;
+		}
+		fmt++;
+	}
+
+	if(out.flush != 0 && out.length > 0)
+		out.flush(out.buf, out.length);
+
+	return out.total;
+}
+
+/**
+ * @brief	Adds a character to the output, flushing the buffer first if
+ * 			it is full
+ */
+static void put_char(format_output_t *out, char c)
+{
+	if(out->length == out->size)
+	{
+		if(out->flush == 0)
+		{
+			out->total++;
+			return;
+		}
+		out->flush(out->buf, out->length);
+		out->length = 0;
+	}
+	out->buf[out->length++] = c;
+	out->total++;
+}
+
+/**
+ * @brief	Adds text to the output, padded to width characters
+ */
+static void put_padded(format_output_t *out, const char *text, uint16_t length,
+					   uint8_t width, uint8_t leftAlign, char padChar)
+{
+	uint16_t i;
+
+	if(!leftAlign)
+	{
+		for(i = length; i < width; i++)
+			put_char(out, padChar);
+	}
+	for(i = 0; i < length; i++)
+		put_char(out, text[i]);
+	if(leftAlign)
+	{
+		for(i = length; i < width; i++)
+			put_char(out, ' ');
+	}
+}
+
+/**
+ * @brief	Flush function of "uart_printf()"
+ */
+static void send_to_uart(const char *text, uint16_t length)
+{
+	UART_send(&g_uart, (const uint8_t *)text, length);
+}
@@ -0,0 +1,45 @@
+/**
+ * @file 	uart_printf.h
+ * @author	Zac Carico
+ * @date 	Oct 16 2026
+ *
+ * @brief	Header file containing all the prototypes and declarations
+ * 			for formatted console output
+ *
+ * @details	A small printf that doesn't use newlib or the heap. The text
+ * 			is formatted into a buffer on the stack and sent to g_uart
+ * 			with one "UART_send()" call, instead of one
+ * 			"UART_polled_tx_string()" call for every piece of a message.
+ * 			Longer output is sent every UART_PRINTF_BUFFER_SIZE bytes.
+ *
+ * 			Conversions: %d %i %u %x %X %c %s %% and %B, with the flags
+ * 			'-' (left align) and '0' (zero pad), a width written as digits
+ * 			or '*', and an ignored 'l' length.
+ *
+ * 			%B dumps a buffer as space separated hex bytes and takes two
+ * 			arguments: a "const uint8_t *" and the number of bytes.
+ *
+ * @code
+	uart_printf("\tResponse was \"0x%02X\"\n\r", response);
+	uart_printf("\tRead %u bytes: %B\n\r", length, buffer, length);
+ * @endcode
+ */
+
+#ifndef UART_PRINTF_H
+#define UART_PRINTF_H
+
+#include <stdint.h>
+#include <stdarg.h>
+#include "core_uart_apb.h"
+
+/** @brief Stack buffer used by "uart_printf()" */
+#define UART_PRINTF_BUFFER_SIZE	128u
+
+extern UART_instance_t g_uart;
+
+uint16_t uart_printf(const char *fmt, ...);
+uint16_t uart_snprintf(char *buf, uint16_t size, const char *fmt, ...);
+uint16_t uart_vformat(char *buf, uint16_t size, void (*flush)(const char *, uint16_t),
+					  const char *fmt, va_list args);
+
+#endif /*UART_PRINTF_H*/
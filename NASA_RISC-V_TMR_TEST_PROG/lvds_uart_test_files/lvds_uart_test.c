@@ -0,0 +1,232 @@
+/**
+ * @file 	lvds_uart_test.c
+ * @author	Zac Carico
+ * @date 	Oct 16 2026
+ *
+ * @brief	Function definitions of lvds_uart_test.h
+ */
+
+#include "lvds_uart_test.h"
+#include "uart_printf.h"
+
+/** @brief Names of each PRBS_TYPE */
+static const char * const prbs_names[NUM_PRBS_TYPES] = {
+	"PRBS-7",
+	"PRBS-15",
+	"PRBS-31"
+};
+
+/**
+ * @brief	Counts kept for one reporting interval of
+ * 			"lvds_uart_test_stream()"
+ */
+typedef struct {
+	uint32_t start;
+	uint32_t txBytes;
+	uint32_t rxBytes;
+	uint32_t busyCycles;
+	uint64_t bitErrors;
+	uint8_t overrun;
+} lvds_interval_t;
+
+static void lvds_display_interval(const prbs_checker_t *checker, lvds_interval_t *interval,
+								  uint32_t elapsedSeconds);
+static void lvds_format_ber(char *buf, uint16_t size, uint64_t errors, uint64_t bits);
+
+/**
+ * @brief	The main function of the LVDS UART test. Asks for the
+ * 			sequence, loopback and reporting interval, then streams
+ * 			until a key is pressed.
+ */
+void lvds_uart_test_handler(void)
+{
+	uint32_t type = 0;
+	uint32_t interval = 0;
+	uint8_t loopback = 0;
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\rWELCOME TO THE LVDS UART TEST!\n\r");
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tSequence (0 = PRBS-7, 1 = PRBS-15, 2 = PRBS-31):\n\r");
+	type = get_dec_from_user(1);
+	if(type >= NUM_PRBS_TYPES)
+		type = PRBS_31;
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tReport interval in seconds (1-30):\n\r");
+	interval = get_dec_from_user(2);
+	if(interval == 0 || interval > LVDS_MAX_INTERVAL_SECONDS)
+		interval = 1;
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tUse the Core16550 internal loopback? (y/n)\n\r");
+	loopback = get_yes_no_from_user();
+
+	lvds_uart_test_stream((PRBS_TYPE)type, loopback, interval);
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\rLeaving LVDS UART Test Program\n\r");
+}
+
+/**
+ * @brief	Sends a PRBS stream on g_uart_16550 and checks the stream
+ * 			received at the same time, until a key is pressed on the
+ * 			console
+ *
+ * @details	Each pass of the loop tops up the transmit ring buffer from
+ * 			one generated chunk and checks whatever has arrived in the
+ * 			receive ring buffer, so nothing is kept beyond one chunk
+ * 			each way. The receiver synchronizes itself to the stream,
+ * 			so the far end can start at any point in the sequence.
+ *
+ * 			Every interval the transmit and receive rates, the bit errors
+ * 			and BER, the largest error burst and resynchronizations are
+ * 			printed. "load" is the share of the interval spent
+ * 			generating, queueing and checking; a receive overrun means
+ * 			the checker fell behind the line.
+ *
+ * @param type				Sequence to send and expect
+ * @param loopback			Non-zero to loop the Core16550 back internally
+ * @param intervalSeconds	Time between reports, up to LVDS_MAX_INTERVAL_SECONDS
+ */
+void lvds_uart_test_stream(PRBS_TYPE type, uint8_t loopback, uint32_t intervalSeconds)
+{
+	static prbs_checker_t checker;
+	lvds_interval_t interval;
+	prbs_gen_t gen;
+	uint8_t txChunk[LVDS_CHUNK_SIZE];
+	uint8_t rxChunk[LVDS_CHUNK_SIZE];
+	uint32_t txIdx = LVDS_CHUNK_SIZE;
+	uint32_t intervalCycles = intervalSeconds * SYS_CLK_FREQ;
+	uint32_t elapsedSeconds = 0;
+	uint32_t passStart = 0;
+	size_t txCount = 0;
+	size_t rxCount = 0;
+	uint8_t key = 0;
+
+	UART_16550_tx_flush(&g_uart_16550);
+	UART_16550_set_loopback(&g_uart_16550, loopback);
+	while(UART_16550_get_rx(&g_uart_16550, rxChunk, sizeof(rxChunk)) > 0)
+		;
+	(void)UART_16550_get_rx_status(&g_uart_16550);
+
+	prbs_init(&gen, type);
+	prbs_checker_init(&checker, type);
+
+	uart_printf("\n\r\t%s streaming, press any key to stop\n\r", prbs_names[type]);
+	UART_tx_flush(&g_uart);
+
+	interval.txBytes = 0;
+	interval.rxBytes = 0;
+	interval.busyCycles = 0;
+	interval.bitErrors = 0;
+	interval.overrun = 0;
+	interval.start = get_cycle_count();
+
+	while(UART_get_rx(&g_uart, &key, 1) == 0)
+	{
+		passStart = get_cycle_count();
+
+		if(txIdx == LVDS_CHUNK_SIZE)
+		{
+			prbs_fill(&gen, txChunk, LVDS_CHUNK_SIZE);
+			txIdx = 0;
+		}
+		txCount = UART_16550_queue_tx(&g_uart_16550, &txChunk[txIdx], LVDS_CHUNK_SIZE - txIdx);
+		txIdx += txCount;
+
+		rxCount = UART_16550_get_rx(&g_uart_16550, rxChunk, sizeof(rxChunk));
+		prbs_check(&checker, rxChunk, rxCount);
+
+		// An idle pass isn't load, only the ones that moved data
+		if(txCount > 0 || rxCount > 0)
+		{
+			interval.txBytes += txCount;
+			interval.rxBytes += rxCount;
+			interval.busyCycles += get_cycle_count() - passStart;
+		}
+
+		if(get_cycle_count() - interval.start >= intervalCycles)
+		{
+			elapsedSeconds += intervalSeconds;
+			if(UART_16550_get_rx_status(&g_uart_16550) & UART_16550_OVERRUN_ERROR)
+				interval.overrun = 1;
+			lvds_display_interval(&checker, &interval, elapsedSeconds);
+			interval.start += intervalCycles;
+		}
+	}
+
+	UART_16550_tx_flush(&g_uart_16550);
+	UART_16550_set_loopback(&g_uart_16550, 0);
+	while(UART_16550_get_rx(&g_uart_16550, rxChunk, sizeof(rxChunk)) > 0)
+		;
+	(void)UART_16550_get_rx_status(&g_uart_16550);
+
+	uart_printf("\n\r\tTotal: %u KB checked, %u bytes unchecked while synchronizing\n\r",
+				(uint32_t)(checker.bytesChecked >> 10), (uint32_t)checker.bytesUnchecked);
+}
+
+/**
+ * @brief	Prints the results of one reporting interval and starts the
+ * 			counts of the next
+ *
+ * @param checker			Checker of the received stream
+ * @param interval			Counts of the interval, cleared for the next one
+ * @param elapsedSeconds	Time since streaming started
+ */
+static void lvds_display_interval(const prbs_checker_t *checker, lvds_interval_t *interval,
+								  uint32_t elapsedSeconds)
+{
+	char ber[16];
+	uint32_t elapsed = get_cycle_count() - interval->start;
+
+	lvds_format_ber(ber, sizeof(ber), checker->bitErrors, checker->bytesChecked * 8u);
+	uart_printf("\t%5us tx %6u B/s rx %6u B/s errors %u BER %s burst %u resync %u load %u%%%s\n\r",
+				elapsedSeconds,
+				(uint32_t)(((uint64_t)interval->txBytes * SYS_CLK_FREQ) / elapsed),
+				(uint32_t)(((uint64_t)interval->rxBytes * SYS_CLK_FREQ) / elapsed),
+				(uint32_t)(checker->bitErrors - interval->bitErrors), ber,
+				checker->maxBurstBits, checker->syncLosses,
+				(uint32_t)(((uint64_t)interval->busyCycles * 100u) / elapsed),
+				interval->overrun ? " OVERRUN" : "");
+
+	interval->txBytes = 0;
+	interval->rxBytes = 0;
+	interval->busyCycles = 0;
+	interval->bitErrors = checker->bitErrors;
+	interval->overrun = 0;
+}
+
+/**
+ * @brief	Formats a bit error rate as "m.me-ee". With no errors the
+ * 			rate is shown as below one error in the bits checked.
+ *
+ * @param buf		Buffer for the text, at least 10 bytes
+ * @param size		Size of buf
+ * @param errors	Bit errors
+ * @param bits		Bits checked
+ */
+static void lvds_format_ber(char *buf, uint16_t size, uint64_t errors, uint64_t bits)
+{
+	uint64_t scale = 1;
+	uint32_t mantissa = 0;
+	uint32_t exponent = 0;
+	const char *prefix = "";
+
+	if(bits == 0)
+	{
+		uart_snprintf(buf, size, "-");
+		return;
+	}
+	if(errors == 0)
+	{
+		errors = 1;
+		prefix = "<";
+	}
+
+	// Scale until the ratio has two significant digits, 10 to 99
+	while(errors * scale < bits * 10u)
+	{
+		scale *= 10u;
+		exponent++;
+	}
+	mantissa = (uint32_t)((errors * scale) / bits);
+	uart_snprintf(buf, size, "%s%u.%ue-%02u", prefix, mantissa / 10u, mantissa % 10u,
+				  exponent - 1u);
+}
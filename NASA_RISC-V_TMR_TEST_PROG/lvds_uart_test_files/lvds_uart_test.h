@@ -0,0 +1,47 @@
+/**
+ * @file 	lvds_uart_test.h
+ * @author	Zac Carico
+ * @date 	Oct 16 2026
+ *
+ * @brief	Header file containing all the prototypes
+ * 			and declarations for the LVDS UART test
+ *
+ * @details	The LVDS link is driven by g_uart_16550. A PRBS stream is
+ * 			sent and checked in both directions at once until a key is
+ * 			pressed on the console, with the results printed every
+ * 			reporting interval. The far end is either another board
+ * 			sending the same PRBS, a cable loopback or the Core16550
+ * 			internal loopback.
+ */
+
+#ifndef LVDS_UART_TEST_H
+#define LVDS_UART_TEST_H
+
+#include <stdint.h>
+#include "hw_platform.h"
+#include "core_uart_apb.h"
+#include "core_16550.h"
+#include "user_handler.h"
+#include "cycle_count.h"
+#include "prbs.h"
+
+/**
+ * @brief	Bytes generated or checked at a time. Matches the size of
+ * 			the Core16550 FIFOs so every loop can keep up with a full
+ * 			receive FIFO.
+ */
+#define LVDS_CHUNK_SIZE				UART_16550_FIFO_DEPTH
+
+/**
+ * @brief	Longest reporting interval that can be entered, in seconds.
+ * 			The interval in cycles has to fit in 32 bits.
+ */
+#define LVDS_MAX_INTERVAL_SECONDS	30u
+
+extern UART_instance_t g_uart;
+extern uart_16550_instance_t g_uart_16550;
+
+void lvds_uart_test_handler(void);
+void lvds_uart_test_stream(PRBS_TYPE type, uint8_t loopback, uint32_t intervalSeconds);
+
+#endif /*LVDS_UART_TEST_H*/
@@ -1,5 +1,7 @@
 #include "riscv_hal.h"
+#include "hal.h"
 #include "core_uart_apb.h"
+#include "core_16550.h"
 #include "core_gpio.h"
 #include "hw_reg_access.h"
 #include "hw_platform.h"
@@ -7,6 +9,12 @@
 #include "spi_test_prog.h"
 #include "user_handler.h"
 #include "lcd_test.h"
+#include "uart_test.h"
+#include "lvds_uart_test.h"
+#include "adc_test.h"
+#include "accelerometer.h"
+#include "cmd_protocol.h"
+#include "tlog.h"
 
 /**
  * @brief	Used to list the different kinds of tests a user can use. 
@@ -36,6 +44,34 @@ typedef enum{
  */
 UART_instance_t g_uart;
 
+/*-----------------------------------------------------------------------------
+ * Transmit ring buffer for g_uart, drained by the TXRDY interrupt.
+ */
+uint8_t g_uart_tx_ring[UART_TX_RING_SIZE];
+
+/*-----------------------------------------------------------------------------
+ * Receive ring buffer for g_uart, filled by the RXRDY interrupt.
+ */
+uint8_t g_uart_rx_ring[UART_RX_RING_SIZE];
+
+/*-----------------------------------------------------------------------------
+ * Number of TXRDY interrupts taken by g_uart, read by the UART test.
+ */
+volatile uint32_t g_uart_tx_irq_count;
+
+/*-----------------------------------------------------------------------------
+ * Core16550 instance data and ring buffers, drained and filled by its
+ * interrupt handler.
+ */
+uart_16550_instance_t g_uart_16550;
+uint8_t g_uart_16550_tx_ring[UART_16550_TX_RING_SIZE];
+uint8_t g_uart_16550_rx_ring[UART_16550_RX_RING_SIZE];
+
+/*-----------------------------------------------------------------------------
+ * Number of Core16550 interrupts taken, read by the UART test.
+ */
+volatile uint32_t g_uart_16550_irq_count;
+
 /*-----------------------------------------------------------------------------
  * GPIO instance data.
  */
@@ -90,6 +126,43 @@ int main()
 			  BAUD_VALUE_115200,
 			  (DATA_8_BITS | NO_PARITY));
 
+    /**************************************************************************
+     * Send console output through the transmit ring buffer so that printing
+     * does not stall the tests, and receive console input through the receive
+     * ring buffer so that pasted scripts are not lost while a test runs.
+     * PLIC_init() must only be called here as it disables every external
+     * interrupt. RXRDY has the higher priority as a late receive loses data.
+     *************************************************************************/
+    PLIC_init();
+    UART_set_tx_ring_buffer(&g_uart, g_uart_tx_ring, sizeof(g_uart_tx_ring));
+    UART_set_rx_ring_buffer(&g_uart, g_uart_rx_ring, sizeof(g_uart_rx_ring),
+    						UART_RX_LINE_EDIT | UART_RX_ECHO);
+    PLIC_SetPriority(UART0_TXRDY_IRQn, 1);
+    PLIC_SetPriority(UART0_RXRDY_IRQn, 2);
+    PLIC_EnableIRQ(UART0_RXRDY_IRQn);
+
+    /**************************************************************************
+     * Core16550 moves data through its FIFOs in bursts and masks its own
+     * interrupt sources, so its PLIC input stays enabled.
+     *************************************************************************/
+    UART_16550_init(&g_uart_16550,
+    				CORE16550_BASE_ADDR,
+					CORE16550_BAUD_VALUE_115200,
+					(UART_16550_DATA_8_BITS | UART_16550_NO_PARITY));
+    UART_16550_set_tx_ring_buffer(&g_uart_16550, g_uart_16550_tx_ring,
+    							  sizeof(g_uart_16550_tx_ring));
+    UART_16550_set_rx_ring_buffer(&g_uart_16550, g_uart_16550_rx_ring,
+    							  sizeof(g_uart_16550_rx_ring),
+								  UART_16550_FIFO_EIGHT_BYTES);
+    PLIC_SetPriority(CORE16550_IRQn, 2);
+    PLIC_EnableIRQ(CORE16550_IRQn);
+    HAL_enable_interrupts();
+
+    /**************************************************************************
+     * Accept binary command frames on the console alongside the menus.
+     *************************************************************************/
+    cmd_protocol_init();
+
 #endif
     /*
      * Infinite loop.
@@ -143,16 +216,16 @@ void testProgramManager(void)
 					spi_test_handler();
 					break;
 				case UART_TEST:
-					displayTestUnavailable();
+					uart_test_handler();
 					break;
 				case LVDS_UART_TEST:
-					displayTestUnavailable();
+					lvds_uart_test_handler();
 					break;
 				case ADC_TEST:
-					displayTestUnavailable();
+					adc_test_handler();
 					break;
 				case SENSORS_TEST:
-					displayTestUnavailable();
+					accel_test_handler();
 					break;
 				case LCD_SCREEN_TEST:
 					lcd_test();
@@ -184,17 +257,17 @@ void displayIncorrectCommand(void)
  */
 void displayTestList(void)
 {
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tTEST IDs:\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t-(0) GPIO_TEST\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t-(1) I2C_TEST\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t-(2) SPI_TEST\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t-(3) UART_TEST\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t-(4) LVDS_UART_TEST\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t-(5) ADC_TEST\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t-(6) SENSOR_TEST\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t-(7) LCD_SCREEN_TEST\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t-(8) CPU_TEST\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t-(9) UNIT_TEST\n\r");
+	TLOG0("\tTEST IDs:\n\r"
+	      "\t-(0) GPIO_TEST\n\r"
+	      "\t-(1) I2C_TEST\n\r"
+	      "\t-(2) SPI_TEST\n\r"
+	      "\t-(3) UART_TEST\n\r"
+	      "\t-(4) LVDS_UART_TEST\n\r"
+	      "\t-(5) ADC_TEST\n\r"
+	      "\t-(6) SENSOR_TEST\n\r"
+	      "\t-(7) LCD_SCREEN_TEST\n\r"
+	      "\t-(8) CPU_TEST\n\r"
+	      "\t-(9) UNIT_TEST\n\r");
 }
 
 /**
@@ -211,8 +284,41 @@ void displayTestUnavailable(void)
  */
 void displayCommandsList(void)
 {
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tCOMMANDS:\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t- h\t display these commands\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t- d\t display tests IDs\n\r");
+	TLOG0("\tCOMMANDS:\n\r"
+	      "\t- h\t display these commands\n\r"
+	      "\t- d\t display tests IDs\n\r");
 }
 
+/**
+ * @brief	Interrupt handler for the TXRDY signal of g_uart. Disables 
+ * 			itself once the transmit ring buffer is empty, since TXRDY 
+ * 			stays asserted while the transmitter is idle.
+ */
+uint8_t External_1_IRQHandler(void)
+{
+	g_uart_tx_irq_count++;
+	if(UART_tx_isr(&g_uart) == 0)
+		return (EXT_IRQ_DISABLE);
+	return (EXT_IRQ_KEEP_ENABLED);
+}
+
+/**
+ * @brief	Interrupt handler for the RXRDY signal of g_uart. Moves 
+ * 			received characters into the receive ring buffer.
+ */
+uint8_t External_2_IRQHandler(void)
+{
+	UART_rx_isr(&g_uart);
+	return (EXT_IRQ_KEEP_ENABLED);
+}
+
+/**
+ * @brief	Interrupt handler for the INTR signal of g_uart_16550. 
+ * 			Services every pending receive and transmit FIFO interrupt.
+ */
+uint8_t External_3_IRQHandler(void)
+{
+	g_uart_16550_irq_count++;
+	UART_16550_isr(&g_uart_16550);
+	return (EXT_IRQ_KEEP_ENABLED);
+}
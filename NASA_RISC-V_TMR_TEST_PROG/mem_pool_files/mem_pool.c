@@ -0,0 +1,217 @@
+/**
+ * @file 	mem_pool.c
+ * @author	Zac Carico
+ * @date 	Oct 16 2026
+ *
+ * @brief	Function definitions of mem_pool.h
+ */
+
+#include <string.h>
+#include "mem_pool.h"
+#include "hal.h"
+#include "uart_printf.h"
+
+/**
+ * @brief	Storage and free list of one size class
+ *
+ * @details	A free block holds the pointer to the next free block in
+ * 			its first word. inUseMask has a bit set for each block that
+ * 			is allocated, so a block freed twice is caught.
+ */
+typedef struct {
+	uint32_t *storage;
+	uint32_t **freeList;
+	uint32_t inUseMask;
+} mem_pool_class_t;
+
+/** @brief Block storage of each class, as words to keep blocks aligned */
+static uint32_t small_blocks[MEM_POOL_SMALL_BLOCKS * MEM_POOL_SMALL_SIZE / 4u];
+static uint32_t medium_blocks[MEM_POOL_MEDIUM_BLOCKS * MEM_POOL_MEDIUM_SIZE / 4u];
+static uint32_t large_blocks[MEM_POOL_LARGE_BLOCKS * MEM_POOL_LARGE_SIZE / 4u];
+
+static mem_pool_class_t pool_classes[NUM_MEM_POOL_CLASSES];
+static mem_pool_stats_t pool_stats;
+static uint8_t pool_ready = 0;
+
+/**
+ * @brief	Puts every block of every class on its free list and
+ * 			clears the statistics. Called by the first
+ * 			"mem_pool_alloc()" if not called before.
+ *
+ * @warning	Any block still allocated is lost to its owner.
+ */
+void mem_pool_init(void)
+{
+	static uint32_t * const storage[NUM_MEM_POOL_CLASSES] = { small_blocks, medium_blocks, large_blocks };
+	static const uint16_t sizes[NUM_MEM_POOL_CLASSES] = {
+		MEM_POOL_SMALL_SIZE, MEM_POOL_MEDIUM_SIZE, MEM_POOL_LARGE_SIZE
+	};
+	static const uint16_t counts[NUM_MEM_POOL_CLASSES] = {
+		MEM_POOL_SMALL_BLOCKS, MEM_POOL_MEDIUM_BLOCKS, MEM_POOL_LARGE_BLOCKS
+	};
+	uint32_t words = 0;
+	uint16_t i = 0;
+	uint8_t c = 0;
+	psr_t saved_psr = HAL_disable_interrupts();
+
+	memset(&pool_stats, 0, sizeof(pool_stats));
+	for(c = 0; c < NUM_MEM_POOL_CLASSES; c++)
+	{
+		words = sizes[c] / 4u;
+		pool_classes[c].storage = storage[c];
+		pool_classes[c].inUseMask = 0;
+		pool_classes[c].freeList = NULL;
+
+		// Build the list backwards so the first block is handed out first
+		for(i = counts[c]; i > 0; i--)
+		{
+			uint32_t **block = (uint32_t **)&storage[c][(i - 1u) * words];
+			*block = (uint32_t *)pool_classes[c].freeList;
+			pool_classes[c].freeList = block;
+		}
+
+		pool_stats.classes[c].blockSize = sizes[c];
+		pool_stats.classes[c].blocks = counts[c];
+	}
+	pool_ready = 1;
+
+	HAL_restore_interrupts(saved_psr);
+}
+
+/**
+ * @brief	Allocates a block of at least size bytes
+ *
+ * @details	Served from the smallest class the request fits that has a
+ * 			free block. Safe to call from interrupt handlers.
+ *
+ * @param size	Bytes needed, 1 to MEM_POOL_LARGE_SIZE
+ *
+ * @return	The block, or NULL if size is 0, too big, or every class
+ * 			it fits is used up. A NULL is counted in the statistics.
+ */
+void *mem_pool_alloc(size_t size)
+{
+	uint32_t **block = NULL;
+	uint32_t index = 0;
+	uint8_t c = 0;
+	psr_t saved_psr;
+
+	if(!pool_ready)
+		mem_pool_init();
+
+	saved_psr = HAL_disable_interrupts();
+
+	for(c = 0; size > 0 && c < NUM_MEM_POOL_CLASSES; c++)
+	{
+		mem_pool_class_stats_t *stats = &pool_stats.classes[c];
+
+		if(size > stats->blockSize || pool_classes[c].freeList == NULL)
+			continue;
+
+		block = pool_classes[c].freeList;
+		pool_classes[c].freeList = (uint32_t **)*block;
+
+		index = (uint32_t)((uint32_t *)block - pool_classes[c].storage) / (stats->blockSize / 4u);
+		pool_classes[c].inUseMask |= (1u << index);
+
+		stats->allocs++;
+		if(++stats->inUse > stats->peakInUse)
+			stats->peakInUse = stats->inUse;
+		break;
+	}
+
+	if(block == NULL)
+	{
+		pool_stats.failures++;
+		if(size > pool_stats.largestFailure)
+			pool_stats.largestFailure = size;
+	}
+
+	HAL_restore_interrupts(saved_psr);
+	return block;
+}
+
+/**
+ * @brief	Returns a block to its class
+ *
+ * @details	NULL is ignored. A pointer that isn't the start of an
+ * 			allocated block, including one already freed, is left
+ * 			alone and counted as a bad free.
+ *
+ * @param block	Block from "mem_pool_alloc()"
+ */
+void mem_pool_free(void *block)
+{
+	uint32_t *word = (uint32_t *)block;
+	uint32_t offset = 0;
+	uint32_t words = 0;
+	uint32_t index = 0;
+	uint8_t c = 0;
+	psr_t saved_psr;
+
+	if(block == NULL)
+		return;
+
+	saved_psr = HAL_disable_interrupts();
+
+	for(c = 0; c < NUM_MEM_POOL_CLASSES; c++)
+	{
+		mem_pool_class_stats_t *stats = &pool_stats.classes[c];
+
+		words = stats->blockSize / 4u;
+		if(word < pool_classes[c].storage || word >= pool_classes[c].storage + stats->blocks * words)
+			continue;
+
+		offset = (uint32_t)(word - pool_classes[c].storage);
+		index = offset / words;
+		if(offset % words != 0 || !(pool_classes[c].inUseMask & (1u << index)))
+			break;
+
+		pool_classes[c].inUseMask &= ~(1u << index);
+		*(uint32_t ***)word = pool_classes[c].freeList;
+		pool_classes[c].freeList = (uint32_t **)word;
+		stats->inUse--;
+
+		HAL_restore_interrupts(saved_psr);
+		return;
+	}
+
+	pool_stats.badFrees++;
+	HAL_restore_interrupts(saved_psr);
+}
+
+/**
+ * @brief	Copies the usage statistics
+ *
+ * @param stats	Filled with the statistics
+ */
+void mem_pool_get_stats(mem_pool_stats_t *stats)
+{
+	psr_t saved_psr = HAL_disable_interrupts();
+
+	*stats = pool_stats;
+
+	HAL_restore_interrupts(saved_psr);
+}
+
+/**
+ * @brief	Prints the usage of each class and the errors
+ */
+void mem_pool_display_stats(void)
+{
+	mem_pool_stats_t stats;
+	uint8_t c = 0;
+
+	if(!pool_ready)
+		mem_pool_init();
+	mem_pool_get_stats(&stats);
+
+	uart_printf("\tBUFFER POOL:\n\r\t%6s %6s %6s %6s %8s\n\r", "size", "blocks", "used", "peak", "allocs");
+	for(c = 0; c < NUM_MEM_POOL_CLASSES; c++)
+	{
+		uart_printf("\t%6u %6u %6u %6u %8u\n\r", stats.classes[c].blockSize, stats.classes[c].blocks,
+					stats.classes[c].inUse, stats.classes[c].peakInUse, stats.classes[c].allocs);
+	}
+	uart_printf("\tFailed allocations: %u (largest %u bytes), bad frees: %u\n\r", stats.failures,
+				(uint32_t)stats.largestFailure, stats.badFrees);
+}
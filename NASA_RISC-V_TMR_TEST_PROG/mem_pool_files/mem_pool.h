@@ -0,0 +1,71 @@
+/**
+ * @file 	mem_pool.h
+ * @author	Zac Carico
+ * @date 	Oct 16 2026
+ *
+ * @brief	Header file containing all the prototypes
+ * 			and declarations for the fixed-block buffer pool
+ *
+ * @details	Transfer buffers come from a few size classes of fixed
+ * 			blocks in static memory instead of the heap. A request is
+ * 			served from the smallest class it fits with a free block,
+ * 			and every class keeps its free blocks on a list, so both
+ * 			"mem_pool_alloc()" and "mem_pool_free()" take the same
+ * 			time whatever has been allocated before and the pool can
+ * 			never fragment. A request that can't be met, or a free of
+ * 			a pointer the pool didn't hand out, is counted and
+ * 			reported instead of failing silently.
+ */
+
+#ifndef MEM_POOL_H
+#define MEM_POOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/** @brief Block size of each class, in bytes. Multiples of 4. */
+#define MEM_POOL_SMALL_SIZE		16u
+#define MEM_POOL_MEDIUM_SIZE	64u
+#define MEM_POOL_LARGE_SIZE		256u
+
+/** @brief Blocks in each class, at most 32 */
+#define MEM_POOL_SMALL_BLOCKS	16u
+#define MEM_POOL_MEDIUM_BLOCKS	8u
+#define MEM_POOL_LARGE_BLOCKS	4u
+
+/** @brief Size classes of the pool */
+typedef enum {
+	MEM_POOL_SMALL,
+	MEM_POOL_MEDIUM,
+	MEM_POOL_LARGE,
+	NUM_MEM_POOL_CLASSES
+} MEM_POOL_CLASS;
+
+/**
+ * @brief	Usage of one size class
+ */
+typedef struct {
+	uint16_t blockSize;		/**< Bytes per block */
+	uint16_t blocks;		/**< Blocks in the class */
+	uint16_t inUse;			/**< Blocks allocated now */
+	uint16_t peakInUse;		/**< Most blocks allocated at once */
+	uint32_t allocs;		/**< Allocations served */
+} mem_pool_class_stats_t;
+
+/**
+ * @brief	Usage of the whole pool
+ */
+typedef struct {
+	mem_pool_class_stats_t classes[NUM_MEM_POOL_CLASSES];
+	uint32_t failures;		/**< Requests that got NULL */
+	uint32_t badFrees;		/**< Frees of a pointer not allocated from the pool */
+	size_t largestFailure;	/**< Largest request that got NULL */
+} mem_pool_stats_t;
+
+void mem_pool_init(void);
+void *mem_pool_alloc(size_t size);
+void mem_pool_free(void *block);
+void mem_pool_get_stats(mem_pool_stats_t *stats);
+void mem_pool_display_stats(void);
+
+#endif /*MEM_POOL_H*/
@@ -48,6 +48,7 @@
 #define COREGPIO_OUT_BASE_ADDR          0x60001000UL
 #define FLASH_CORE_SPI_BASE             0x60002000UL
 #define CORE16550_BASE_ADDR             0x70007000UL
+#define CORESPI_SLAVE_BASE_ADDR         0x70008000UL
 #define COREI2C_BASE_ADDR				0x60003000UL //not in sample hw_plat
 /***************************************************************************//**
  * Peripheral Interrupts are mapped to the corresponding Mi-V Soft processor
@@ -75,6 +76,13 @@
 
 #define TIMER0_IRQn                     External_30_IRQn
 #define TIMER1_IRQn                     External_31_IRQn
+#define UART0_TXRDY_IRQn                External_1_IRQn
+#define UART0_RXRDY_IRQn                External_2_IRQn
+#define CORE16550_IRQn                  External_3_IRQn
+#define CORESPI_IRQn                    External_4_IRQn
+#define COREI2C_IRQn                    External_5_IRQn
+#define COREGPIO_IN_INT0_IRQn           External_7_IRQn
+#define CORESPI_SLAVE_IRQn              External_8_IRQn
 
 /****************************************************************************
  * Baud value to achieve a 115200 baud rate with a 83MHz system clock.
@@ -83,6 +91,13 @@
  *****************************************************************************/
 #define BAUD_VALUE_115200               (SYS_CLK_FREQ / (16 * 115200)) - 1
 
+/****************************************************************************
+ * Core16550 divisor for a 115200 baud rate. Unlike CoreUARTapb the divisor
+ * is not offset by one:
+ *      DIVISOR = CLOCK / (16 * BAUD_RATE)
+ *****************************************************************************/
+#define CORE16550_BAUD_VALUE_115200     (SYS_CLK_FREQ / (16 * 115200))
+
 /***************************************************************************//**
  * User edit section- Edit sections below if required
  */
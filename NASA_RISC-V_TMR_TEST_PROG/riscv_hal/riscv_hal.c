@@ -10,8 +10,6 @@
 extern "C" {
 #endif
 
-#define RTC_PRESCALER 100UL
-
 #define SUCCESS 0U
 #define ERROR   1U
 
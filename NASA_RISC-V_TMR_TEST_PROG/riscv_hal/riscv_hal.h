@@ -25,6 +25,12 @@ extern "C" {
 #define EXT_IRQ_KEEP_ENABLED                0U
 #define EXT_IRQ_DISABLE                     1U
 
+/*
+ * The machine timer (MTIME) counts at the system clock divided by
+ * RTC_PRESCALER.
+ */
+#define RTC_PRESCALER                       100UL
+
 /*------------------------------------------------------------------------------
  * Interrupt enable/disable.
  */
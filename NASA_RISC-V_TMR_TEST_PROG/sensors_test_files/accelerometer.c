@@ -0,0 +1,334 @@
+/**
+ * @file 	accelerometer.c
+ * @author	Zac Carico
+ * @date 	Oct 16 2026
+ *
+ * @brief	Function definitions of accelerometer.h
+ */
+
+#include "accelerometer.h"
+#include "uart_printf.h"
+
+/** @brief Object for the CoreGPIO input block INT1 is wired to */
+static gpio_instance_t accel_gpio;
+
+/** @brief Batch filled by the watermark interrupt */
+static accel_batch_t accel_batch;
+
+/** @brief Statistics updated by the watermark interrupt */
+static accel_stats_t accel_stats;
+
+/** @brief Called with each batch, may be NULL */
+static accel_batch_handler_t accel_handler = NULL;
+
+/** @brief Latest sample, kept by "accel_test_batch()" for display */
+static volatile accel_sample_t accel_latest;
+
+static void accel_write_reg(uint8_t reg, uint8_t value);
+static void accel_read_regs(uint8_t reg, uint8_t *data, uint16_t length);
+static void accel_reset_stats(void);
+static void accel_test_batch(const accel_batch_t *batch);
+
+/**
+ * @brief	Sets up the accelerometer and starts streaming
+ *
+ * @details	riscv_spi must already be initialized. The sensor is reset,
+ * 			set to the output data rate, its FIFO put in stream mode
+ * 			with the watermark at ACCEL_WATERMARK_SAMPLES and the
+ * 			watermark mapped to INT1, then measurement is started.
+ *
+ * @param odr		Output data rate
+ * @param handler	Called from the interrupt with each batch, or NULL
+ *
+ * @return	1 if the sensor answered with the right device ID, otherwise 0
+ */
+uint8_t accel_init(ACCEL_ODR odr, accel_batch_handler_t handler)
+{
+	uint32_t entries = ACCEL_WATERMARK_SAMPLES * ACCEL_AXES;
+	uint32_t start = 0;
+	uint8_t devId = 0;
+	psr_t saved_psr;
+
+	GPIO_init(&accel_gpio, COREGPIO_IN_BASE_ADDR, GPIO_APB_32_BITS_BUS);
+	// Level triggered, so a FIFO still above the watermark after a
+	// batch is read raises the interrupt again
+	GPIO_config(&accel_gpio, ACCEL_INT_GPIO, GPIO_INPUT_MODE | GPIO_IRQ_LEVEL_HIGH);
+
+	accel_write_reg(ACCEL_REG_SOFT_RESET, ACCEL_SOFT_RESET_KEY);
+	start = get_cycle_count();
+	while(get_cycle_count() - start < SYS_CLK_FREQ / 1000u)
+		;
+
+	accel_read_regs(ACCEL_REG_DEVID_AD, &devId, 1);
+	if(devId != ACCEL_DEVID_AD)
+		return 0;
+
+	accel_write_reg(ACCEL_REG_FILTER_CTL, (uint8_t)odr);
+	accel_write_reg(ACCEL_REG_FIFO_SAMPLES, (uint8_t)entries);
+	accel_write_reg(ACCEL_REG_FIFO_CONTROL, ACCEL_FIFO_STREAM | ((entries > 0xFFu) ? ACCEL_FIFO_AH : 0));
+	accel_write_reg(ACCEL_REG_INTMAP1, ACCEL_INT_FIFO_WATERMARK);
+
+	accel_handler = handler;
+	accel_reset_stats();
+
+	GPIO_clear_irq(&accel_gpio, ACCEL_INT_GPIO);
+	GPIO_enable_irq(&accel_gpio, ACCEL_INT_GPIO);
+	saved_psr = HAL_disable_interrupts();
+	PLIC_SetPriority(COREGPIO_IN_INT0_IRQn, 2);
+	PLIC_EnableIRQ(COREGPIO_IN_INT0_IRQn);
+	HAL_restore_interrupts(saved_psr);
+
+	accel_write_reg(ACCEL_REG_POWER_CTL, ACCEL_POWER_MEASURE);
+	return 1;
+}
+
+/**
+ * @brief	Puts the accelerometer in standby and stops the interrupt
+ */
+void accel_stop(void)
+{
+	psr_t saved_psr;
+
+	saved_psr = HAL_disable_interrupts();
+	PLIC_DisableIRQ(COREGPIO_IN_INT0_IRQn);
+	HAL_restore_interrupts(saved_psr);
+	GPIO_disable_irq(&accel_gpio, ACCEL_INT_GPIO);
+
+	accel_write_reg(ACCEL_REG_POWER_CTL, 0);
+	accel_handler = NULL;
+}
+
+/**
+ * @brief	Copies the streaming statistics
+ *
+ * @param stats	Filled with the statistics
+ * @param reset	Non-zero to start the statistics again afterwards
+ */
+void accel_get_stats(accel_stats_t *stats, uint8_t reset)
+{
+	psr_t saved_psr = HAL_disable_interrupts();
+
+	*stats = accel_stats;
+	if(reset)
+		accel_reset_stats();
+
+	HAL_restore_interrupts(saved_psr);
+}
+
+/**
+ * @brief	Works out the sample rate from the batch timestamps
+ *
+ * @details	The samples of the first batch were taken before its
+ * 			timestamp, so only the ones after it are counted.
+ *
+ * @param stats	Statistics from "accel_get_stats()"
+ *
+ * @return	Samples per second, 0 until two batches have been read
+ */
+uint32_t accel_stats_rate(const accel_stats_t *stats)
+{
+	uint32_t elapsed = stats->lastTimestamp - stats->firstTimestamp;
+
+	if(stats->batches < 2 || elapsed == 0)
+		return 0;
+
+	return (uint32_t)(((uint64_t)(stats->samples - stats->firstCount) * SYS_CLK_FREQ) / elapsed);
+}
+
+/**
+ * @brief	The main function of the sensors test. Streams the
+ * 			accelerometer and prints the statistics every second
+ * 			until a key is pressed.
+ */
+void accel_test_handler(void)
+{
+	static const char * const odrNames[NUM_ACCEL_ODR] = {
+		"12.5", "25", "50", "100", "200", "400"
+	};
+	accel_stats_t stats;
+	uint32_t odr = 0;
+	uint32_t start = 0;
+	uint32_t elapsed = 0;
+	uint8_t axis = 0;
+	uint8_t key = 0;
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\rWELCOME TO THE SENSORS TEST!\n\r");
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tAccelerometer ODR (0 = 12.5, 1 = 25, 2 = 50, 3 = 100, 4 = 200, 5 = 400 Hz):\n\r");
+	odr = get_dec_from_user(1);
+	if(odr >= NUM_ACCEL_ODR)
+		odr = ACCEL_ODR_400_HZ;
+
+	// Brings up riscv_spi
+	spi_test_init();
+	if(accel_init((ACCEL_ODR)odr, accel_test_batch) == 0)
+	{
+		UART_polled_tx_string(&g_uart, (const uint8_t *)"\tERROR: accelerometer not found\n\r");
+		return;
+	}
+
+	uart_printf("\n\r\tStreaming at %s Hz, press any key to stop\n\r", odrNames[odr]);
+	UART_tx_flush(&g_uart);
+
+	start = get_cycle_count();
+	while(UART_get_rx(&g_uart, &key, 1) == 0)
+	{
+		elapsed = get_cycle_count() - start;
+		if(elapsed < SYS_CLK_FREQ)
+			continue;
+		start += elapsed;
+
+		accel_get_stats(&stats, 1);
+		uart_printf("\t%u batches %u S/s read %u cycles/sample load %u.%02u%%\n\r",
+					stats.batches, accel_stats_rate(&stats),
+					stats.samples ? stats.readCycles / stats.samples : 0,
+					(uint32_t)(((uint64_t)stats.readCycles * 100u) / elapsed),
+					(uint32_t)((((uint64_t)stats.readCycles * 10000u) / elapsed) % 100u));
+		for(axis = 0; axis < ACCEL_AXES && stats.samples > 0; axis++)
+		{
+			uart_printf("\t  %c min %6d max %6d mean %6d latest %6d mg\n\r", 'X' + axis,
+						stats.min[axis], stats.max[axis], (int32_t)(stats.sum[axis] / stats.samples),
+						accel_latest.axis[axis]);
+		}
+	}
+
+	accel_stop();
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\rLeaving Sensors Test Program\n\r");
+}
+
+/**
+ * @brief	Interrupt handler for INT1 of the accelerometer, the FIFO
+ * 			watermark. Reads every complete sample in one burst.
+ *
+ * @details	Each FIFO entry is one axis, tagged in bits 15-14, with a
+ * 			sign-extended 14 bit value below. Entries are read in whole
+ * 			samples; a sample that doesn't start on an X entry, as
+ * 			after a FIFO overrun, is skipped until the next X.
+ */
+uint8_t External_7_IRQHandler(void)
+{
+	static uint8_t raw[ACCEL_MAX_BATCH_SAMPLES * ACCEL_AXES * 2u];
+	static const uint8_t readFifo = ACCEL_CMD_READ_FIFO;
+	uint32_t timestamp = get_cycle_count();
+	uint8_t level[2];
+	uint16_t entries = 0;
+	uint16_t entry = 0;
+	uint16_t i = 0;
+	uint8_t tag = 0;
+	uint8_t next = 0;
+	uint8_t axis = 0;
+	accel_sample_t *sample;
+
+	accel_read_regs(ACCEL_REG_FIFO_ENTRIES_L, level, sizeof(level));
+	entries = (uint16_t)(level[0] | ((level[1] & 0x03u) << 8));
+	if(entries > ACCEL_MAX_BATCH_SAMPLES * ACCEL_AXES)
+		entries = ACCEL_MAX_BATCH_SAMPLES * ACCEL_AXES;
+	entries -= entries % ACCEL_AXES;
+
+	SPI_set_slave_select(accelerometer_dev.spi, accelerometer_dev.spi_sel);
+	SPI_transfer_block(accelerometer_dev.spi, &readFifo, 1, raw, (uint16_t)(entries * 2u));
+	SPI_clear_slave_select(accelerometer_dev.spi, accelerometer_dev.spi_sel);
+
+	accel_batch.timestamp = timestamp;
+	accel_batch.count = 0;
+	for(i = 0; i < entries; i++)
+	{
+		entry = (uint16_t)(raw[i * 2u] | (raw[i * 2u + 1u] << 8));
+		tag = (uint8_t)(entry >> ACCEL_ENTRY_TAG_SHIFT);
+		if(tag != next)
+		{
+			// Out of step, start again from this entry if it is an X
+			next = 0;
+			if(tag != 0)
+				continue;
+		}
+
+		sample = &accel_batch.samples[accel_batch.count];
+		sample->axis[tag] = (int16_t)((int16_t)(entry << 2) >> 2);
+		if(++next == ACCEL_AXES)
+		{
+			next = 0;
+			accel_batch.count++;
+		}
+	}
+	accel_batch.readCycles = get_cycle_count() - timestamp;
+
+	if(accel_batch.count > 0)
+	{
+		if(accel_stats.batches == 0)
+		{
+			accel_stats.firstTimestamp = timestamp;
+			accel_stats.firstCount = accel_batch.count;
+		}
+		accel_stats.lastTimestamp = timestamp;
+		accel_stats.batches++;
+		accel_stats.readCycles += accel_batch.readCycles;
+
+		for(i = 0; i < accel_batch.count; i++)
+		{
+			for(axis = 0; axis < ACCEL_AXES; axis++)
+			{
+				int16_t value = accel_batch.samples[i].axis[axis];
+				if(accel_stats.samples == 0 && i == 0)
+				{
+					accel_stats.min[axis] = value;
+					accel_stats.max[axis] = value;
+				}
+				if(value < accel_stats.min[axis])
+					accel_stats.min[axis] = value;
+				if(value > accel_stats.max[axis])
+					accel_stats.max[axis] = value;
+				accel_stats.sum[axis] += value;
+			}
+		}
+		accel_stats.samples += accel_batch.count;
+
+		if(accel_handler != NULL)
+			accel_handler(&accel_batch);
+	}
+
+	GPIO_clear_irq(&accel_gpio, ACCEL_INT_GPIO);
+	return (EXT_IRQ_KEEP_ENABLED);
+}
+
+/**
+ * @brief	Writes one accelerometer register
+ */
+static void accel_write_reg(uint8_t reg, uint8_t value)
+{
+	uint8_t cmd[3] = { ACCEL_CMD_WRITE_REG, reg, value };
+
+	SPI_set_slave_select(accelerometer_dev.spi, accelerometer_dev.spi_sel);
+	SPI_transfer_block(accelerometer_dev.spi, cmd, sizeof(cmd), NULL, 0);
+	SPI_clear_slave_select(accelerometer_dev.spi, accelerometer_dev.spi_sel);
+}
+
+/**
+ * @brief	Reads consecutive accelerometer registers in one burst
+ */
+static void accel_read_regs(uint8_t reg, uint8_t *data, uint16_t length)
+{
+	uint8_t cmd[2] = { ACCEL_CMD_READ_REG, reg };
+
+	SPI_set_slave_select(accelerometer_dev.spi, accelerometer_dev.spi_sel);
+	SPI_transfer_block(accelerometer_dev.spi, cmd, sizeof(cmd), data, length);
+	SPI_clear_slave_select(accelerometer_dev.spi, accelerometer_dev.spi_sel);
+}
+
+/**
+ * @brief	Starts the statistics again
+ */
+static void accel_reset_stats(void)
+{
+	memset(&accel_stats, 0, sizeof(accel_stats));
+}
+
+/**
+ * @brief	Batch handler of the sensors test, keeps the newest sample
+ */
+static void accel_test_batch(const accel_batch_t *batch)
+{
+	uint8_t axis = 0;
+
+	for(axis = 0; axis < ACCEL_AXES; axis++)
+		accel_latest.axis[axis] = batch->samples[batch->count - 1u].axis[axis];
+}
@@ -0,0 +1,128 @@
+/**
+ * @file 	accelerometer.h
+ * @author	Zac Carico
+ * @date 	Oct 16 2026
+ *
+ * @brief	Header file containing all the prototypes
+ * 			and declarations for the accelerometer driver
+ *
+ * @details	The accelerometer on accelerometer_dev is assumed to be an
+ * 			ADXL362. Its FIFO runs in stream mode and its INT1 pin,
+ * 			mapped to the FIFO watermark, is wired to ACCEL_INT_GPIO of
+ * 			the CoreGPIO input block. On the watermark interrupt every
+ * 			complete sample in the FIFO, up to ACCEL_MAX_BATCH_SAMPLES,
+ * 			is read in a single SPI burst and handed on as one batch
+ * 			stamped with the cycle count the interrupt was taken at.
+ */
+
+#ifndef ACCELEROMETER_H
+#define ACCELEROMETER_H
+
+#include <stdint.h>
+#include "hw_platform.h"
+#include "riscv_hal.h"
+#include "hal.h"
+#include "core_gpio.h"
+#include "core_spi.h"
+#include "spi_test_prog.h"
+#include "cycle_count.h"
+
+/** @brief ADXL362 SPI commands */
+#define ACCEL_CMD_WRITE_REG		0x0Au
+#define ACCEL_CMD_READ_REG		0x0Bu
+#define ACCEL_CMD_READ_FIFO		0x0Du
+
+/** @brief ADXL362 registers */
+#define ACCEL_REG_DEVID_AD		0x00u
+#define ACCEL_REG_FIFO_ENTRIES_L	0x0Cu
+#define ACCEL_REG_SOFT_RESET	0x1Fu
+#define ACCEL_REG_FIFO_CONTROL	0x28u
+#define ACCEL_REG_FIFO_SAMPLES	0x29u
+#define ACCEL_REG_INTMAP1		0x2Au
+#define ACCEL_REG_FILTER_CTL	0x2Cu
+#define ACCEL_REG_POWER_CTL		0x2Du
+
+/** @brief ADXL362 register values */
+#define ACCEL_DEVID_AD			0xADu
+#define ACCEL_SOFT_RESET_KEY	0x52u
+#define ACCEL_FIFO_STREAM		0x02u
+#define ACCEL_FIFO_AH			0x08u
+#define ACCEL_INT_FIFO_WATERMARK	0x04u
+#define ACCEL_POWER_MEASURE		0x02u
+
+/** @brief Output data rates, the ODR field of FILTER_CTL */
+typedef enum {
+	ACCEL_ODR_12_5_HZ,
+	ACCEL_ODR_25_HZ,
+	ACCEL_ODR_50_HZ,
+	ACCEL_ODR_100_HZ,
+	ACCEL_ODR_200_HZ,
+	ACCEL_ODR_400_HZ,
+	NUM_ACCEL_ODR
+} ACCEL_ODR;
+
+/** @brief Axes of a sample, also the tag in bits 15-14 of a FIFO entry */
+#define ACCEL_AXES				3u
+#define ACCEL_ENTRY_TAG_SHIFT	14u
+
+/** @brief Input of the CoreGPIO input block wired to INT1 */
+#define ACCEL_INT_GPIO			GPIO_0
+
+/** @brief Samples in the FIFO that raise the watermark interrupt */
+#define ACCEL_WATERMARK_SAMPLES	32u
+
+/**
+ * @brief	Most samples read by one interrupt. Anything left keeps
+ * 			INT1 high, so the interrupt is taken again straight away.
+ */
+#define ACCEL_MAX_BATCH_SAMPLES	64u
+
+/**
+ * @brief	One sample, in mg at the default +/-2 g range
+ */
+typedef struct {
+	int16_t axis[ACCEL_AXES];
+} accel_sample_t;
+
+/**
+ * @brief	Samples read by one watermark interrupt
+ *
+ * @details	timestamp is the cycle count when the interrupt was taken,
+ * 			which is close to the time of the newest sample. Sample n
+ * 			was taken about (count - 1 - n) sample periods earlier.
+ */
+typedef struct {
+	uint32_t timestamp;		/**< Cycle count of the watermark interrupt */
+	uint32_t readCycles;	/**< Cycles spent reading the FIFO */
+	uint16_t count;			/**< Samples in the batch */
+	accel_sample_t samples[ACCEL_MAX_BATCH_SAMPLES];
+} accel_batch_t;
+
+/**
+ * @brief	Streaming statistics, kept from the batches since they
+ * 			were last reset
+ */
+typedef struct {
+	uint32_t batches;
+	uint32_t samples;
+	uint32_t firstTimestamp;	/**< Timestamp of the first batch */
+	uint32_t firstCount;		/**< Samples in the first batch */
+	uint32_t lastTimestamp;		/**< Timestamp of the latest batch */
+	uint32_t readCycles;		/**< Cycles spent reading the FIFO */
+	int16_t min[ACCEL_AXES];
+	int16_t max[ACCEL_AXES];
+	int64_t sum[ACCEL_AXES];
+} accel_stats_t;
+
+/**
+ * @brief	Called from the watermark interrupt with each batch
+ */
+typedef void (*accel_batch_handler_t)(const accel_batch_t *batch);
+
+uint8_t accel_init(ACCEL_ODR odr, accel_batch_handler_t handler);
+void accel_stop(void);
+void accel_get_stats(accel_stats_t *stats, uint8_t reset);
+uint32_t accel_stats_rate(const accel_stats_t *stats);
+void accel_test_handler(void);
+
+#endif /*ACCELEROMETER_H*/
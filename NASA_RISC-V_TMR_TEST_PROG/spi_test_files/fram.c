@@ -0,0 +1,239 @@
+/**
+ * @file 	fram.c
+ * @author	Zac Carico
+ * @date 	Oct 16 2026
+ *
+ * @brief	Function definitions of fram.h
+ */
+
+#include "fram.h"
+#include "cycle_count.h"
+#include "uart_printf.h"
+
+/** @brief Configuration for the FRAM on the SPI FLASH select line */
+fram_t g_fram;
+
+static void fram_desc(spi_block_desc_t *desc, const fram_t *fram, const uint8_t *tx, uint16_t txSize,
+					  uint8_t *rx, uint16_t rxSize, uint8_t flags);
+static void fram_stream(fram_t *fram, uint8_t opcode, uint32_t address, const uint8_t *txData,
+						uint8_t *rxData, uint32_t length);
+
+/**
+ * @brief	Sets up an FRAM on an SPI device
+ *
+ * @details	The SPI object of the device must already be initialized
+ * 			with "SPI_init()", as the chunk size is taken from its FIFO
+ * 			depth.
+ *
+ * @param fram			FRAM object to set up
+ * @param device		SPI device the FRAM is on
+ * @param size			Size of the FRAM in bytes
+ * @param addressBytes	Number of address bytes, 2 or 3
+ */
+void fram_init(fram_t *fram, spi_dev *device, uint32_t size, uint8_t addressBytes)
+{
+	uint32_t depth = device->spi->fifo_depth;
+
+	fram->device = device;
+	fram->size = size;
+	fram->addressBytes = (addressBytes == 2) ? 2 : 3;
+
+	// As much as a descriptor can hold, rounded down to a multiple of the
+	// FIFO depth (65504 bytes with a 32 frame FIFO). Chunks only matter for
+	// transfers longer than that; within one the driver keeps the FIFO full.
+	fram->chunkSize = (uint16_t)((0xFFFFu / depth) * depth);
+}
+
+/**
+ * @brief	Reads the FRAM status register
+ *
+ * @param fram	FRAM to read
+ *
+ * @return	The status register
+ */
+uint8_t fram_read_status(fram_t *fram)
+{
+	static const uint8_t rdsr = FRAM_RDSR;
+	spi_block_desc_t desc;
+	uint8_t status = 0;
+
+	fram_desc(&desc, fram, &rdsr, 1, &status, 1, 0);
+	SPI_transfer_queue(fram->device->spi, &desc, 1);
+
+	return status;
+}
+
+/**
+ * @brief	Reads any number of bytes in one burst
+ *
+ * @param fram		FRAM to read
+ * @param address	First address to read
+ * @param data		Buffer to fill
+ * @param length	Number of bytes to read
+ *
+ * @return	1 if the data was read, 0 if it runs past the end of the FRAM
+ */
+uint8_t fram_read(fram_t *fram, uint32_t address, uint8_t *data, uint32_t length)
+{
+	if(address > fram->size || length > fram->size - address)
+		return 0;
+
+	if(length > 0)
+		fram_stream(fram, FRAM_READ, address, NULL, data, length);
+
+	return 1;
+}
+
+/**
+ * @brief	Writes any number of bytes in one burst
+ *
+ * @details	The write enable latch is set before the write, as the FRAM
+ * 			clears it at the end of every write.
+ *
+ * @param fram		FRAM to write
+ * @param address	First address to write
+ * @param data		Bytes to write
+ * @param length	Number of bytes to write
+ *
+ * @return	1 if the data was written, 0 if it runs past the end of the FRAM
+ */
+uint8_t fram_write(fram_t *fram, uint32_t address, const uint8_t *data, uint32_t length)
+{
+	if(address > fram->size || length > fram->size - address)
+		return 0;
+
+	if(length > 0)
+		fram_stream(fram, FRAM_WRITE, address, data, NULL, length);
+
+	return 1;
+}
+
+/**
+ * @brief	Measures the read and write bandwidth of the FRAM
+ *
+ * @details	FRAM_BENCH_SIZE bytes at the address are saved, then
+ * 			written with a pattern and read back FRAM_BENCH_PASSES
+ * 			times, and restored afterwards. Each burst is timed on
+ * 			its own and the read data is checked against the pattern.
+ *
+ * @param fram		FRAM to test
+ * @param address	First address of the test area
+ */
+void fram_benchmark(fram_t *fram, uint32_t address)
+{
+	static uint8_t saved[FRAM_BENCH_SIZE];
+	static uint8_t pattern[FRAM_BENCH_SIZE];
+	static uint8_t readBack[FRAM_BENCH_SIZE];
+	uint32_t writeCycles = 0;
+	uint32_t readCycles = 0;
+	uint32_t startCycles = 0;
+	uint32_t mismatches = 0;
+	uint32_t pass = 0;
+	uint32_t i = 0;
+	uint64_t bytes = (uint64_t)FRAM_BENCH_SIZE * FRAM_BENCH_PASSES;
+
+	if(fram_read(fram, address, saved, FRAM_BENCH_SIZE) == 0)
+	{
+		uart_printf("\tAddress 0x%X is too close to the end of the FRAM\n\r", address);
+		return;
+	}
+
+	for(pass = 0; pass < FRAM_BENCH_PASSES; pass++)
+	{
+		for(i = 0; i < FRAM_BENCH_SIZE; i++)
+			pattern[i] = (uint8_t)(i * 7u + pass);
+
+		startCycles = get_cycle_count();
+		fram_write(fram, address, pattern, FRAM_BENCH_SIZE);
+		writeCycles += get_cycle_count() - startCycles;
+
+		startCycles = get_cycle_count();
+		fram_read(fram, address, readBack, FRAM_BENCH_SIZE);
+		readCycles += get_cycle_count() - startCycles;
+
+		for(i = 0; i < FRAM_BENCH_SIZE; i++)
+		{
+			if(readBack[i] != pattern[i])
+				mismatches++;
+		}
+	}
+
+	fram_write(fram, address, saved, FRAM_BENCH_SIZE);
+
+	uart_printf("\n\r\t%u passes of %u bytes at 0x%X\n\r", FRAM_BENCH_PASSES, FRAM_BENCH_SIZE, address);
+	uart_printf("\tWrite: %u B/s, %u cycles/byte\n\r",
+				(uint32_t)((bytes * SYS_CLK_FREQ) / writeCycles), (uint32_t)(writeCycles / bytes));
+	uart_printf("\tRead:  %u B/s, %u cycles/byte\n\r",
+				(uint32_t)((bytes * SYS_CLK_FREQ) / readCycles), (uint32_t)(readCycles / bytes));
+	uart_printf("\tMismatched bytes: %u\n\r", mismatches);
+}
+
+/**
+ * @brief	Fills in a descriptor for the FRAM's select line
+ */
+static void fram_desc(spi_block_desc_t *desc, const fram_t *fram, const uint8_t *tx, uint16_t txSize,
+					  uint8_t *rx, uint16_t rxSize, uint8_t flags)
+{
+	desc->slave = fram->device->spi_sel;
+	desc->cmd_buffer = tx;
+	desc->cmd_byte_size = txSize;
+	desc->rx_buffer = rx;
+	desc->rx_byte_size = rxSize;
+	desc->flags = flags;
+}
+
+/**
+ * @brief	Runs one READ or WRITE burst of any length
+ *
+ * @details	The opcode and address go in the first descriptor, and the
+ * 			data follows in chunks of up to chunkSize bytes, all under
+ * 			the same chip select. Each chunk is queued with its own 
+ * 			"SPI_transfer_queue()" call, the WREN and header going with 
+ * 			the first. A WRITE is preceded by WREN in its own chip select.
+ *
+ * @param fram		FRAM to access
+ * @param opcode	FRAM_READ or FRAM_WRITE
+ * @param address	First address
+ * @param txData	Bytes to write, NULL when reading
+ * @param rxData	Buffer to read into, NULL when writing
+ * @param length	Number of bytes, at least 1
+ */
+static void fram_stream(fram_t *fram, uint8_t opcode, uint32_t address, const uint8_t *txData,
+						uint8_t *rxData, uint32_t length)
+{
+	static const uint8_t wren = FRAM_WREN;
+	spi_block_desc_t desc[3];
+	uint8_t header[4];
+	uint8_t headerSize = 0;
+	uint8_t count = 0;
+	uint16_t chunk = 0;
+	int8_t shift = 0;
+
+	if(opcode == FRAM_WRITE)
+		fram_desc(&desc[count++], fram, &wren, 1, NULL, 0, 0);
+
+	header[headerSize++] = opcode;
+	for(shift = (int8_t)((fram->addressBytes - 1) * 8); shift >= 0; shift -= 8)
+		header[headerSize++] = (uint8_t)(address >> shift);
+	fram_desc(&desc[count++], fram, header, headerSize, NULL, 0, SPI_DESC_KEEP_SELECTED);
+
+	while(length > 0)
+	{
+		chunk = (length > fram->chunkSize) ? fram->chunkSize : (uint16_t)length;
+		length -= chunk;
+
+		if(txData != NULL)
+		{
+			fram_desc(&desc[count++], fram, txData, chunk, NULL, 0, length > 0 ? SPI_DESC_KEEP_SELECTED : 0);
+			txData += chunk;
+		}
+		else
+		{
+			fram_desc(&desc[count++], fram, NULL, 0, rxData, chunk, length > 0 ? SPI_DESC_KEEP_SELECTED : 0);
+			rxData += chunk;
+		}
+
+		SPI_transfer_queue(fram->device->spi, desc, count);
+		count = 0;
+	}
+}
@@ -0,0 +1,68 @@
+/**
+ * @file 	fram.h
+ * @author	Zac Carico
+ * @date 	Oct 16 2026
+ *
+ * @brief	Header file containing all the prototypes
+ * 			and declarations for the SPI FRAM driver
+ *
+ * @details	The FRAM has no pages or write delay, so a READ or WRITE
+ * 			streams any length under one chip select, the address
+ * 			incrementing on its own. The CoreSPI driver keeps its FIFO
+ * 			full within a descriptor, but a descriptor holds at most
+ * 			0xFFFF bytes, so longer transfers are split into chunks of
+ * 			nearly that size. Each chunk is its own "SPI_transfer_queue()"
+ * 			call, with the slave kept selected between them.
+ */
+
+#ifndef FRAM_H
+#define FRAM_H
+
+#include <stdint.h>
+#include "core_spi.h"
+#include "spi_test_prog.h"
+
+/** @brief FRAM opcodes */
+#define FRAM_WREN				0x06u
+#define FRAM_WRDI				0x04u
+#define FRAM_RDSR				0x05u
+#define FRAM_WRSR				0x01u
+#define FRAM_READ				0x03u
+#define FRAM_WRITE				0x02u
+
+/** @brief Write enable latch bit of the status register */
+#define FRAM_STATUS_WEL			0x02u
+
+/**
+ * @brief	Size and address length of the fitted FRAM. Assumed to be
+ * 			a 1 Mbit part with 3 address bytes; parts up to 512 Kbit use 2.
+ */
+#define FRAM_SIZE_BYTES			0x20000u
+#define FRAM_ADDRESS_BYTES		3u
+
+/** @brief Bytes moved by each pass of "fram_benchmark()" */
+#define FRAM_BENCH_SIZE			1024u
+
+/** @brief Passes timed by "fram_benchmark()" */
+#define FRAM_BENCH_PASSES		16u
+
+/**
+ * @brief	Structure used to store an FRAM configuration
+ */
+typedef struct {
+	spi_dev *device;		/**< SPI device the FRAM is on */
+	uint32_t size;			/**< Size of the FRAM in bytes */
+	uint8_t addressBytes;	/**< 2 or 3 address bytes after the opcode */
+	uint16_t chunkSize;		/**< Bytes per SPI_transfer_queue() descriptor */
+} fram_t;
+
+/** @brief Object for the FRAM on fram_dev */
+extern fram_t g_fram;
+
+void fram_init(fram_t *fram, spi_dev *device, uint32_t size, uint8_t addressBytes);
+uint8_t fram_read_status(fram_t *fram);
+uint8_t fram_read(fram_t *fram, uint32_t address, uint8_t *data, uint32_t length);
+uint8_t fram_write(fram_t *fram, uint32_t address, const uint8_t *data, uint32_t length);
+void fram_benchmark(fram_t *fram, uint32_t address);
+
+#endif /*FRAM_H*/
@@ -8,6 +8,10 @@
 
 
 #include "spi_test_prog.h"
+#include "fram.h"
+#include "mem_pool.h"
+#include "tlog.h"
+#include "uart_printf.h"
 
 /** @brief Configuration for the SPI FLASH */
 spi_dev fram_dev = {
@@ -45,6 +49,49 @@ spi_dev accelerometer_dev = {
 		.spi_sel = SPI_SLAVE_5
 };
 
+/** @brief Device of the asynchronous read in progress, deselected on completion */
+static spi_dev * volatile async_dev = NULL;
+
+/** @brief Names of each SPI_FILL */
+static const char * const spi_fill_names[NUM_SPI_FILL] = {
+	"frame",
+	"half",
+	"full",
+	"queued",
+	"duplex",
+	"fast"
+};
+
+/** @brief Transfer sizes of "spi_test_throughput_sweep()" */
+static const uint16_t spi_bench_sizes[] = { 1, 4, 16, 64, 256, 1024, 4096 };
+
+/**
+ * @brief	Gaps, in cycles, the master leaves between frames sent to the 
+ * 			slave by "spi_test_slave_loopback()". 0 sends back to back.
+ */
+static const uint16_t spi_slave_gaps[] = { 2048, 1024, 512, 256, 128, 64, 32, 0 };
+
+/** @brief Object for the second CoreSPI, run as a slave */
+static spi_instance_t riscv_spi_slave;
+
+/** @brief Frames the slave received in the last block, set at slave select end */
+static volatile uint32_t slave_block_size;
+
+/** @brief Set when the slave has seen the end of a block */
+static volatile uint8_t slave_block_done;
+
+/** @brief Calls of "SPI_isr()" for the slave and the cycles spent in them */
+static volatile uint32_t slave_isr_count;
+static volatile uint32_t slave_isr_cycles;
+
+static void spi_test_async_done(spi_instance_t *this_spi, uint32_t rx_size);
+static uint8_t *spi_test_alloc_custom_buffer(uint8_t *numBytes);
+static void spi_test_slave_block_rx(uint8_t *rx_buff, uint32_t rx_size);
+static uint32_t spi_bench_run(spi_dev *device, const uint8_t *data, SPI_FILL fill, uint16_t size,
+							  uint32_t repeats);
+static uint32_t spi_fast_run(spi_dev *device, uint8_t fast, const uint8_t *cmd, uint16_t cmdSize,
+							 uint8_t *rx, uint16_t rxSize);
+
 /**
  * @brief	Initializes the SPI test. First function called 
  * 			in the test's main function.
@@ -60,6 +107,14 @@ void spi_test_init(void)
 
 	SPI_init(&riscv_spi, FLASH_CORE_SPI_BASE, 32);
 	SPI_configure_master_mode(&riscv_spi);
+	fram_init(&g_fram, &fram_dev, FRAM_SIZE_BYTES, FRAM_ADDRESS_BYTES);
+
+	// Drives "SPI_transfer_block_async()". Enabling is a read-modify-write
+	// of the PLIC, so keep the UART interrupts out of it.
+	psr_t saved_psr = HAL_disable_interrupts();
+	PLIC_SetPriority(CORESPI_IRQn, 1);
+	PLIC_EnableIRQ(CORESPI_IRQn);
+	HAL_restore_interrupts(saved_psr);
 }
 
 /**
@@ -145,6 +200,78 @@ void spi_test_write(spi_dev *device, uint8_t *data, uint8_t data_size, uint8_t *
 	SPI_clear_slave_select(device->spi, device->spi_sel);
 }
 
+/**
+ * @brief	Starts the same read as "spi_test_read()" but returns as 
+ * 			soon as the transmit FIFO is loaded
+ * 
+ * @details	The transfer is finished by "SPI_isr()" from the CoreSPI 
+ * 			interrupt, which deselects the device once the last byte 
+ * 			is in. "spi_test_async_busy()" reports when data is ready.
+ * 			command and data must stay valid until then.
+ * 
+ * @param device  	Pointer to device to read data from
+ * @param command	Pointer to read command to send to the device
+ * @param data		Pointer/array to be filled with incomming data
+ * @param data_size Size of the data array
+ * 
+ * @return	1 : The read was started
+ * 			0 : The CoreSPI refused it, the device is deselected again
+ */
+uint8_t spi_test_read_async(spi_dev *device, uint8_t *command, uint8_t *data, uint16_t data_size)
+{
+	uint8_t started = 0;
+	psr_t saved_psr;
+
+	while(spi_test_async_busy())
+		;
+
+	// The transfer can complete as soon as it starts, so the completion 
+	// handler is held off until async_dev says which device to deselect
+	SPI_set_slave_select(device->spi, device->spi_sel);
+	saved_psr = HAL_disable_interrupts();
+	started = SPI_transfer_block_async(device->spi, command, 1, data, data_size, spi_test_async_done);
+	if(started)
+		async_dev = device;
+	HAL_restore_interrupts(saved_psr);
+
+	if(!started)
+		SPI_clear_slave_select(device->spi, device->spi_sel);
+
+	return started;
+}
+
+/**
+ * @brief	Checks for an asynchronous read in progress
+ * 
+ * @return	1 until the read started by "spi_test_read_async()" has 
+ * 			completed, otherwise 0
+ */
+uint8_t spi_test_async_busy(void)
+{
+	return async_dev != NULL;
+}
+
+/**
+ * @brief	Completion handler of "spi_test_read_async()", called 
+ * 			from "SPI_isr()". Deselects the device.
+ */
+static void spi_test_async_done(spi_instance_t *this_spi, uint32_t rx_size)
+{
+	(void)rx_size;
+	SPI_clear_slave_select(this_spi, async_dev->spi_sel);
+	async_dev = NULL;
+}
+
+/**
+ * @brief	Interrupt handler for the CoreSPI interrupt. Carries 
+ * 			asynchronous transfers on from the receive FIFO.
+ */
+uint8_t External_4_IRQHandler(void)
+{
+	SPI_isr(&riscv_spi);
+	return (EXT_IRQ_KEEP_ENABLED);
+}
+
 /**
  * @brief	The main function of the "SPI_TEST_PROG". Lets user change 
  * 			settings and test different aspects of the SDI
@@ -184,6 +311,27 @@ void spi_test_handler(void)
 			case '3':
 				spi_test_send_read_command();
 				break;
+			case '4':
+				spi_test_async_compare();
+				break;
+			case '5':
+				spi_test_queue_compare();
+				break;
+			case '6':
+				spi_test_fram_benchmark();
+				break;
+			case '7':
+				spi_test_throughput_sweep();
+				break;
+			case '8':
+				spi_test_slave_loopback();
+				break;
+			case '9':
+				spi_test_fast_path_compare();
+				break;
+			case 'p':
+				mem_pool_display_stats();
+				break;
 			default:
 				spi_test_display_incorrect_command();
 				break;
@@ -320,7 +468,6 @@ void spi_test_write_single_byte(void)
 	uint8_t writeData[1] = {0};
 	uint8_t response = 0;
 	uint8_t sendData = 0;
-	char hexStr[5];
 
 	UART_polled_tx_string(&g_uart, (const uint8_t *)"You have entered the \"Send Single Byte\" tool\n\r\n\r");
 
@@ -332,24 +479,15 @@ void spi_test_write_single_byte(void)
 		UART_polled_tx_string(&g_uart, (const uint8_t *)"\tEnter Value to write:");
 		writeData[0] = (uint8_t)(get_bytes_from_user(1));
 
-		UART_polled_tx_string(&g_uart, (const uint8_t *)"\tSend write command \"");
-		int_to_single_byte_string(spi_command_byte, hexStr);
-		UART_polled_tx_string(&g_uart, (const uint8_t *)hexStr);
-		UART_polled_tx_string(&g_uart, (const uint8_t *)"\" and value \"");
-		int_to_single_byte_string(writeData[0], hexStr);
-		UART_polled_tx_string(&g_uart, (const uint8_t *)hexStr);
-		UART_polled_tx_string(&g_uart, (const uint8_t *)"\"?");
+		uart_printf("\tSend write command \"0x%02X\" and value \"0x%02X\"?",
+					spi_command_byte, writeData[0]);
 		if(get_yes_no_from_user() == 1)
 			sendData = 1;
 	}
 	spi_test_write(selected_dev, writeData, 1, &response);
 
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\r\tData has been sent!\n\r");
-
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tResponse was \"");
-	int_to_single_byte_string(response, hexStr);
-	UART_polled_tx_string(&g_uart, (const uint8_t *)hexStr);
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\"\n\r");
+	uart_printf("\n\r\tData has been sent!\n\r"
+				"\tResponse was \"0x%02X\"\n\r", response);
 }
 
 /**
@@ -401,12 +539,8 @@ void spi_test_write_quad_byte(void)
 	}
 
 	spi_test_write(selected_dev, writeData, 4, &response);
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\r\tData has been sent!\n\r");
-
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tResponse was \"");
-	int_to_single_byte_string(response, hexStr);
-	UART_polled_tx_string(&g_uart, (const uint8_t *)hexStr);
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\"\n\r");
+	uart_printf("\n\r\tData has been sent!\n\r"
+				"\tResponse was \"0x%02X\"\n\r", response);
 }
 
 /**
@@ -432,8 +566,9 @@ void spi_test_write_custom_byte(void)
 
 	UART_polled_tx_string(&g_uart, (const uint8_t *)"You have entered the \"Send Custom Byte\" tool\n\r\n\r");
 	UART_polled_tx_string(&g_uart, (const uint8_t *)"How many bytes would you like to send?\n\r");
-	numBytes = get_dec_from_user(3);
-	writeData = malloc(sizeof(int8_t)*numBytes);
+	writeData = spi_test_alloc_custom_buffer(&numBytes);
+	if(writeData == NULL)
+		return;
 
 	while(sendData == 0)
 	{
@@ -476,7 +611,7 @@ void spi_test_write_custom_byte(void)
 	int_to_single_byte_string(response, hexStr);
 	UART_polled_tx_string(&g_uart, (const uint8_t *)hexStr);
 	UART_polled_tx_string(&g_uart, (const uint8_t *)"\"\n\r");
-	free(writeData);
+	mem_pool_free(writeData);
 }
 
 /**
@@ -534,7 +669,6 @@ void spi_test_read_single_byte(void)
  */
 void spi_test_read_quad_byte(void)
 {
-	uint8_t i = 0;
 	uint8_t sendData = 0;
 	uint8_t temp[1] = {0};
 	uint8_t readData[4];
@@ -558,16 +692,8 @@ void spi_test_read_quad_byte(void)
 	spi_test_read(selected_dev, &spi_command_byte, readData, 4);
 	UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\r\tData has been sent!\n\r");
 
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tRead Data is ");
-	for(i = 0; i < 4; i++)
-	{
-		UART_polled_tx_string(&g_uart, (const uint8_t *)" \"");
-		int_to_single_byte_string(readData[i], hexStr);
-		UART_polled_tx_string(&g_uart, (const uint8_t *)hexStr);
-		UART_polled_tx_string(&g_uart, (const uint8_t *)"\"");
-	}
-
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\r");
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tRead Data is:\n\r");
+	hexdump(readData, 4);
 }
 
 /**
@@ -583,7 +709,6 @@ void spi_test_read_quad_byte(void)
  */
 void spi_test_read_custom_byte(void)
 {
-	uint8_t i = 0;
 	uint8_t numBytes = 0;
 	uint8_t sendData = 0;
 	uint8_t temp[1] = {0};
@@ -592,8 +717,9 @@ void spi_test_read_custom_byte(void)
 
 	UART_polled_tx_string(&g_uart, (const uint8_t *)"You have entered the \"Send Custom Byte\" tool\n\r\n\r");
 	UART_polled_tx_string(&g_uart, (const uint8_t *)"How many bytes would you like to send?\n\r");
-	numBytes = get_dec_from_user(3);
-	readData = malloc(sizeof(int8_t)*numBytes);
+	readData = spi_test_alloc_custom_buffer(&numBytes);
+	if(readData == NULL)
+		return;
 
 	while(sendData == 0)
 	{
@@ -612,17 +738,593 @@ void spi_test_read_custom_byte(void)
 	spi_test_read(selected_dev, &spi_command_byte, readData, numBytes);
 	UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\r\tData has been sent!\n\r");
 
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tRead Data is ");
-	for(i = 0; i < 4; i++)
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tRead Data is:\n\r");
+	hexdump(readData, numBytes);
+	mem_pool_free(readData);
+}
+
+/**
+ * @brief	Gets a byte count from the user and a buffer of that size
+ * 			from the buffer pool, for the custom number of bytes tools
+ * 
+ * @param numBytes	Set to the byte count entered
+ * 
+ * @return	The buffer, or NULL if the count is not 1 to 255 or the 
+ * 			pool has no block for it. The reason has been reported.
+ */
+static uint8_t *spi_test_alloc_custom_buffer(uint8_t *numBytes)
+{
+	uint32_t count = get_dec_from_user(3);
+	uint8_t *buffer = NULL;
+
+	if(count == 0 || count > UINT8_MAX)
 	{
-		UART_polled_tx_string(&g_uart, (const uint8_t *)" \"");
-		int_to_single_byte_string(readData[i], hexStr);
-		UART_polled_tx_string(&g_uart, (const uint8_t *)hexStr);
-		UART_polled_tx_string(&g_uart, (const uint8_t *)"\"");
+		uart_printf("\tERROR: %u bytes is out of range (1-%u)\n\r", count, UINT8_MAX);
+		return NULL;
+	}
+
+	buffer = mem_pool_alloc(count);
+	if(buffer == NULL)
+	{
+		uart_printf("\tERROR: no %u byte buffer free in the pool\n\r", count);
+		mem_pool_display_stats();
+		return NULL;
 	}
 
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\r");
-	free(readData);
+	*numBytes = (uint8_t)count;
+	return buffer;
+}
+
+/**
+ * @brief	Reads SPI_ASYNC_TEST_SIZE bytes from the selected device 
+ * 			with "spi_test_read()" and again with 
+ * 			"spi_test_read_async()", and shows how long the CPU is 
+ * 			held by each
+ * 
+ * @details	The polled read holds the CPU for the whole transfer. The 
+ * 			asynchronous read only holds it to load the transmit FIFO, 
+ * 			after which a counting loop stands in for other work until 
+ * 			the completion handler runs. Both reads should return the 
+ * 			same data.
+ */
+void spi_test_async_compare(void)
+{
+	static uint8_t polledData[SPI_ASYNC_TEST_SIZE];
+	static uint8_t asyncData[SPI_ASYNC_TEST_SIZE];
+	uint32_t polledCycles = 0;
+	uint32_t startCycles = 0;
+	uint32_t returnCycles = 0;
+	uint32_t doneCycles = 0;
+	uint32_t freeLoops = 0;
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"You have entered the \"Polled vs Interrupt Read\" tool\n\r\n\r");
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tEnter Read Command:");
+	spi_command_byte = get_bytes_from_user(1);
+
+	startCycles = get_cycle_count();
+	spi_test_read(selected_dev, &spi_command_byte, polledData, SPI_ASYNC_TEST_SIZE);
+	polledCycles = get_cycle_count() - startCycles;
+
+	startCycles = get_cycle_count();
+	if(spi_test_read_async(selected_dev, &spi_command_byte, asyncData, SPI_ASYNC_TEST_SIZE) == 0)
+	{
+		UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\r\tThe CoreSPI refused the interrupt read\n\r");
+		return;
+	}
+	returnCycles = get_cycle_count() - startCycles;
+	while(spi_test_async_busy())
+		freeLoops++;
+	doneCycles = get_cycle_count() - startCycles;
+
+	uart_printf("\n\r\t%u bytes read\n\r", SPI_ASYNC_TEST_SIZE);
+	uart_printf("\tPolled:    CPU held %u cycles\n\r", polledCycles);
+	uart_printf("\tInterrupt: CPU held %u cycles, done after %u cycles, %u free loops\n\r",
+				returnCycles, doneCycles, freeLoops);
+	uart_printf("\tData %s\n\r",
+				memcmp(polledData, asyncData, SPI_ASYNC_TEST_SIZE) == 0 ? "matches" : "DIFFERS");
+}
+
+/**
+ * @brief	Fills in a transaction descriptor for "SPI_transfer_queue()" 
+ * 			that does the same read as "spi_test_read()"
+ * 
+ * @details	Every device in one queue must be on the same SPI object, 
+ * 			the one passed to "SPI_transfer_queue()".
+ * 
+ * @param desc		Descriptor to fill in
+ * @param device  	Pointer to device to read data from
+ * @param command	Pointer to read command to send to the device
+ * @param data		Pointer/array to be filled with incomming data
+ * @param data_size Size of the data array
+ */
+void spi_test_desc_read(spi_block_desc_t *desc, spi_dev *device, uint8_t *command, uint8_t *data,
+						uint16_t data_size)
+{
+	desc->slave = device->spi_sel;
+	desc->cmd_buffer = command;
+	desc->cmd_byte_size = 1;
+	desc->rx_buffer = data;
+	desc->rx_byte_size = data_size;
+	desc->flags = 0;
+}
+
+/**
+ * @brief	Polls the FRAM, ADC and accelerometer SPI_QUEUE_TEST_ROUNDS 
+ * 			times with "spi_test_read()" and again with one 
+ * 			"SPI_transfer_queue()" per round, and compares the time
+ * 
+ * @details	Each device is read SPI_QUEUE_TEST_SIZE bytes with the same 
+ * 			read command. The single reads pay for the FIFO flush and 
+ * 			CoreSPI restart of every call, the queue only once per round.
+ */
+void spi_test_queue_compare(void)
+{
+	spi_dev *devices[SPI_QUEUE_TEST_DEVICES] = { &fram_dev, &adc_dev, &accelerometer_dev };
+	uint8_t singleData[SPI_QUEUE_TEST_DEVICES][SPI_QUEUE_TEST_SIZE];
+	uint8_t queueData[SPI_QUEUE_TEST_DEVICES][SPI_QUEUE_TEST_SIZE];
+	spi_block_desc_t queue[SPI_QUEUE_TEST_DEVICES];
+	uint32_t singleCycles = 0;
+	uint32_t queueCycles = 0;
+	uint32_t startCycles = 0;
+	uint32_t round = 0;
+	uint32_t dev = 0;
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"You have entered the \"Single vs Queued Read\" tool\n\r\n\r");
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tEnter Read Command:");
+	spi_command_byte = get_bytes_from_user(1);
+
+	for(dev = 0; dev < SPI_QUEUE_TEST_DEVICES; dev++)
+		spi_test_desc_read(&queue[dev], devices[dev], &spi_command_byte, queueData[dev], SPI_QUEUE_TEST_SIZE);
+
+	startCycles = get_cycle_count();
+	for(round = 0; round < SPI_QUEUE_TEST_ROUNDS; round++)
+	{
+		for(dev = 0; dev < SPI_QUEUE_TEST_DEVICES; dev++)
+			spi_test_read(devices[dev], &spi_command_byte, singleData[dev], SPI_QUEUE_TEST_SIZE);
+	}
+	singleCycles = get_cycle_count() - startCycles;
+
+	startCycles = get_cycle_count();
+	for(round = 0; round < SPI_QUEUE_TEST_ROUNDS; round++)
+		SPI_transfer_queue(&riscv_spi, queue, SPI_QUEUE_TEST_DEVICES);
+	queueCycles = get_cycle_count() - startCycles;
+
+	uart_printf("\n\r\t%u rounds of %u devices x %u bytes\n\r", SPI_QUEUE_TEST_ROUNDS,
+				SPI_QUEUE_TEST_DEVICES, SPI_QUEUE_TEST_SIZE);
+	uart_printf("\tSingle: %u cycles per round\n\r", singleCycles / SPI_QUEUE_TEST_ROUNDS);
+	uart_printf("\tQueued: %u cycles per round\n\r", queueCycles / SPI_QUEUE_TEST_ROUNDS);
+	uart_printf("\tData %s\n\r",
+				memcmp(singleData, queueData, sizeof(queueData)) == 0 ? "matches" : "DIFFERS");
+}
+
+/**
+ * @brief	Runs "fram_benchmark()" on an address entered by the user
+ * 
+ * @details	The test area is overwritten while the benchmark runs and 
+ * 			restored at the end.
+ */
+void spi_test_fram_benchmark(void)
+{
+	uint32_t address = 0;
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"You have entered the \"FRAM Bandwidth\" tool\n\r\n\r");
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tEnter 3 byte test address:");
+	address = get_bytes_from_user(3);
+
+	uart_printf("\n\r\tStatus register: 0x%02X\n\r", fram_read_status(&g_fram));
+	uart_printf("\t%u bytes from 0x%X are overwritten, then restored. Continue?[Y/N] ",
+				FRAM_BENCH_SIZE, address);
+	if(get_yes_no_from_user() == 1)
+		fram_benchmark(&g_fram, address);
+}
+
+/**
+ * @brief	Measures what the SPI achieves for transfer sizes from 1 
+ * 			to SPI_BENCH_MAX_SIZE bytes with each SPI_FILL strategy
+ * 
+ * @details	Meant for an external port with MOSI looped back to MISO, 
+ * 			so nothing else on the bus is disturbed. The loopback is 
+ * 			checked first with a full-duplex exchange.
+ * 
+ * 			The bus time of a frame is measured first: transfers that 
+ * 			fit in the FIFO are loaded before the CoreSPI is enabled 
+ * 			and then go out back to back, so the difference between a 
+ * 			full and a half FIFO transfer is the time of the extra 
+ * 			frames alone. For each size and strategy the rate, CPU 
+ * 			cycles per byte and the average gap added to each frame 
+ * 			are printed. A gap near 0 means the bus is the limit, 
+ * 			otherwise the driver is.
+ */
+void spi_test_throughput_sweep(void)
+{
+	static uint8_t data[SPI_BENCH_MAX_SIZE];
+	static uint8_t echo[SPI_BENCH_MAX_SIZE];
+	spi_dev *device = &external_spi_0;
+	uint32_t mismatches = 0;
+	uint16_t depth = riscv_spi.fifo_depth;
+	uint32_t frameCycles = 0;
+	uint32_t cycles = 0;
+	uint32_t repeats = 0;
+	uint32_t frames = 0;
+	uint32_t gap = 0;
+	uint32_t i = 0;
+	uint8_t fill = 0;
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"You have entered the \"SPI Throughput Sweep\" tool\n\r\n\r");
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tLoopback port (0 = EXTERNAL_SPI_0, 1 = EXTERNAL_SPI_1):\n\r");
+	if(get_dec_from_user(1) == 1)
+		device = &external_spi_1;
+
+	for(i = 0; i < SPI_BENCH_MAX_SIZE; i++)
+		data[i] = (uint8_t)i;
+
+	// Only a full-duplex exchange gets back what was sent
+	memset(echo, 0, sizeof(echo));
+	SPI_set_slave_select(device->spi, device->spi_sel);
+	SPI_transfer_duplex(device->spi, data, echo, SPI_BENCH_MAX_SIZE);
+	SPI_clear_slave_select(device->spi, device->spi_sel);
+	for(i = 0; i < SPI_BENCH_MAX_SIZE; i++)
+	{
+		if(echo[i] != data[i])
+			mismatches++;
+	}
+	uart_printf("\n\r\tLoopback check: %u of %u bytes differ%s\n\r", mismatches, SPI_BENCH_MAX_SIZE,
+				mismatches ? ", is MOSI looped to MISO?" : "");
+
+	// Bus time of (depth - depth / 2) frames, averaged over 64 runs
+	cycles = spi_bench_run(device, data, SPI_FILL_FULL_FIFO, depth, 64)
+		   - spi_bench_run(device, data, SPI_FILL_FULL_FIFO, depth / 2u, 64);
+	frameCycles = cycles / (64u * (depth - depth / 2u));
+	if(frameCycles == 0)
+		frameCycles = 1;
+
+	uart_printf("\tBus: %u cycles per frame, %u B/s at most\n\r", frameCycles,
+				SYS_CLK_FREQ / frameCycles);
+	uart_printf("\t%5s %-7s %9s %11s %10s\n\r", "size", "fill", "B/s", "cycles/B", "gap/frame");
+
+	for(i = 0; i < sizeof(spi_bench_sizes) / sizeof(spi_bench_sizes[0]); i++)
+	{
+		repeats = SPI_BENCH_TOTAL_BYTES / spi_bench_sizes[i];
+		frames = repeats * spi_bench_sizes[i];
+
+		for(fill = 0; fill < NUM_SPI_FILL; fill++)
+		{
+			cycles = spi_bench_run(device, data, (SPI_FILL)fill, spi_bench_sizes[i], repeats);
+			gap = cycles / frames;
+			gap = (gap > frameCycles) ? gap - frameCycles : 0;
+
+			uart_printf("\t%5u %-7s %9u %11u %10u\n\r", spi_bench_sizes[i], spi_fill_names[fill],
+						(uint32_t)(((uint64_t)frames * SYS_CLK_FREQ) / cycles), cycles / frames, gap);
+		}
+	}
+}
+
+/**
+ * @brief	Sends the same transfer a number of times with one FIFO 
+ * 			fill strategy
+ * 
+ * @details	The fill strategies other than SPI_FILL_QUEUED shrink the 
+ * 			FIFO depth "SPI_transfer_block()" works with, which limits 
+ * 			how many frames it keeps in flight. The depth is put back 
+ * 			before returning.
+ * 
+ * @param device	Device to send to
+ * @param data		Bytes to send
+ * @param fill		FIFO fill strategy
+ * @param size		Bytes per transfer
+ * @param repeats	Number of transfers
+ * 
+ * @return	CPU cycles taken by all the transfers
+ */
+static uint32_t spi_bench_run(spi_dev *device, const uint8_t *data, SPI_FILL fill, uint16_t size,
+							  uint32_t repeats)
+{
+	spi_block_desc_t desc;
+	uint16_t depth = device->spi->fifo_depth;
+	uint32_t startCycles = 0;
+	uint32_t cycles = 0;
+	uint32_t i = 0;
+
+	desc.slave = device->spi_sel;
+	desc.cmd_buffer = data;
+	desc.cmd_byte_size = size;
+	desc.rx_buffer = NULL;
+	desc.rx_byte_size = 0;
+	desc.flags = 0;
+
+	if(fill == SPI_FILL_FRAME)
+		device->spi->fifo_depth = 1;
+	else if(fill == SPI_FILL_HALF_FIFO)
+		device->spi->fifo_depth = depth / 2u;
+
+	startCycles = get_cycle_count();
+	for(i = 0; i < repeats; i++)
+	{
+		if(fill == SPI_FILL_QUEUED)
+		{
+			SPI_transfer_queue(device->spi, &desc, 1);
+		}
+		else if(fill == SPI_FILL_DUPLEX)
+		{
+			SPI_set_slave_select(device->spi, device->spi_sel);
+			SPI_transfer_duplex(device->spi, data, NULL, size);
+			SPI_clear_slave_select(device->spi, device->spi_sel);
+		}
+		else if(fill == SPI_FILL_FAST)
+		{
+			SPI_set_slave_select(device->spi, device->spi_sel);
+			SPI_transfer_block_fast(device->spi, data, size, NULL, 0);
+			SPI_clear_slave_select(device->spi, device->spi_sel);
+		}
+		else
+		{
+			SPI_set_slave_select(device->spi, device->spi_sel);
+			SPI_transfer_block(device->spi, data, size, NULL, 0);
+			SPI_clear_slave_select(device->spi, device->spi_sel);
+		}
+	}
+	cycles = get_cycle_count() - startCycles;
+
+	device->spi->fifo_depth = depth;
+	return cycles;
+}
+
+/**
+ * @brief	Times "SPI_transfer_block()" against 
+ * 			"SPI_transfer_block_fast()" at each size of the sweep
+ * 
+ * @details	Meant for an external port with MOSI looped back to MISO. 
+ * 			Each size is timed as a write of that many bytes and as a 
+ * 			1 byte command followed by a read of that many bytes, 
+ * 			averaged over SPI_FAST_TEST_REPEATS transfers. The bytes 
+ * 			read by the two functions are compared, so any difference 
+ * 			in what the fast path does shows up as mismatches. 
+ * 
+ * 			The speedup is largest for small transfers and a fast 
+ * 			SCLK; once the bus is the limit both take the same time.
+ */
+void spi_test_fast_path_compare(void)
+{
+	static uint8_t data[SPI_BENCH_MAX_SIZE];
+	static uint8_t blockRx[SPI_BENCH_MAX_SIZE];
+	static uint8_t fastRx[SPI_BENCH_MAX_SIZE];
+	spi_dev *device = &external_spi_0;
+	uint32_t writeBlock = 0;
+	uint32_t writeFast = 0;
+	uint32_t readBlock = 0;
+	uint32_t readFast = 0;
+	uint32_t mismatches = 0;
+	uint16_t size = 0;
+	uint32_t i = 0;
+	uint32_t j = 0;
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"You have entered the \"SPI Fast Path\" tool\n\r\n\r");
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tLoopback port (0 = EXTERNAL_SPI_0, 1 = EXTERNAL_SPI_1):\n\r");
+	if(get_dec_from_user(1) == 1)
+		device = &external_spi_1;
+
+	for(i = 0; i < SPI_BENCH_MAX_SIZE; i++)
+		data[i] = (uint8_t)(i * 13u + 1u);
+
+	uart_printf("\n\r\t%5s %13s %13s %7s %13s %13s %7s %5s\n\r", "size", "write block", "write fast",
+				"speedup", "read block", "read fast", "speedup", "diff");
+
+	for(i = 0; i < sizeof(spi_bench_sizes) / sizeof(spi_bench_sizes[0]); i++)
+	{
+		size = spi_bench_sizes[i];
+
+		writeBlock = spi_fast_run(device, 0, data, size, NULL, 0);
+		writeFast = spi_fast_run(device, 1, data, size, NULL, 0);
+
+		memset(blockRx, 0xA5, size);
+		memset(fastRx, 0x5A, size);
+		readBlock = spi_fast_run(device, 0, data, 1, blockRx, size);
+		readFast = spi_fast_run(device, 1, data, 1, fastRx, size);
+
+		mismatches = 0;
+		for(j = 0; j < size; j++)
+		{
+			if(blockRx[j] != fastRx[j])
+				mismatches++;
+		}
+
+		// Cycles per transfer, speedup in hundredths
+		uart_printf("\t%5u %13u %13u %4u.%02u %13u %13u %4u.%02u %5u\n\r", size,
+					writeBlock, writeFast, (writeBlock * 100u / writeFast) / 100u,
+					(writeBlock * 100u / writeFast) % 100u,
+					readBlock, readFast, (readBlock * 100u / readFast) / 100u,
+					(readBlock * 100u / readFast) % 100u, mismatches);
+	}
+}
+
+/**
+ * @brief	Runs the same transfer SPI_FAST_TEST_REPEATS times with 
+ * 			"SPI_transfer_block()" or "SPI_transfer_block_fast()"
+ * 
+ * @param device	Device to transfer with
+ * @param fast		1 for "SPI_transfer_block_fast()"
+ * @param cmd		Command bytes to send
+ * @param cmdSize	Number of command bytes
+ * @param rx		Buffer for the bytes read, NULL if rxSize is 0
+ * @param rxSize	Number of bytes to read after the command
+ * 
+ * @return	Mean CPU cycles per transfer, at least 1
+ */
+static uint32_t spi_fast_run(spi_dev *device, uint8_t fast, const uint8_t *cmd, uint16_t cmdSize,
+							 uint8_t *rx, uint16_t rxSize)
+{
+	uint32_t startCycles = 0;
+	uint32_t cycles = 0;
+	uint32_t i = 0;
+
+	startCycles = get_cycle_count();
+	for(i = 0; i < SPI_FAST_TEST_REPEATS; i++)
+	{
+		SPI_set_slave_select(device->spi, device->spi_sel);
+		if(fast)
+			SPI_transfer_block_fast(device->spi, cmd, cmdSize, rx, rxSize);
+		else
+			SPI_transfer_block(device->spi, cmd, cmdSize, rx, rxSize);
+		SPI_clear_slave_select(device->spi, device->spi_sel);
+	}
+	cycles = (get_cycle_count() - startCycles) / SPI_FAST_TEST_REPEATS;
+
+	return (cycles != 0) ? cycles : 1;
+}
+
+/**
+ * @brief	Sends blocks to the second CoreSPI, run as a slave on the 
+ * 			EXTERNAL_SPI_1 port, at falling gaps between frames to find 
+ * 			the fastest rate the slave keeps up with
+ * 
+ * @details	The slave uses the driver's block mode: "SPI_isr()" moves 
+ * 			each received frame into a buffer and refills its TX FIFO, 
+ * 			and the end of slave select reports the block size. The 
+ * 			CoreSPI clock is set in the FPGA design, so the rate is 
+ * 			varied with the gap the master leaves between frames.
+ * 
+ * 			For each gap the frame rate, the SCLK that would carry it 
+ * 			back to back, the frames and bytes the slave got right, 
+ * 			its receive overflows and the "SPI_isr()" cycles per frame 
+ * 			are printed. The fastest clean rate is the one to keep 
+ * 			under.
+ */
+void spi_test_slave_loopback(void)
+{
+	static uint8_t masterTx[SPI_SLAVE_TEST_FRAMES];
+	static uint8_t slaveTx[SPI_SLAVE_TEST_FRAMES];
+	static uint8_t slaveRx[SPI_SLAVE_TEST_FRAMES];
+	spi_block_desc_t desc;
+	uint32_t fastestRate = 0;
+	uint32_t frameRate = 0;
+	uint32_t overflows = 0;
+	uint32_t mismatches = 0;
+	uint32_t isrCycles = 0;
+	uint32_t start = 0;
+	uint32_t elapsed = 0;
+	uint32_t frame = 0;
+	uint32_t i = 0;
+	uint8_t timedOut = 0;
+	psr_t saved_psr;
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"You have entered the \"SPI Slave Loopback\" tool\n\r\n\r");
+
+	for(i = 0; i < SPI_SLAVE_TEST_FRAMES; i++)
+	{
+		masterTx[i] = (uint8_t)(i * 3u + 1u);
+		slaveTx[i] = (uint8_t)~i;
+	}
+
+	SPI_init(&riscv_spi_slave, CORESPI_SLAVE_BASE_ADDR, 32);
+	SPI_configure_slave_mode(&riscv_spi_slave);
+	SPI_set_slave_block_buffers(&riscv_spi_slave, slaveTx, sizeof(slaveTx), slaveRx, sizeof(slaveRx),
+								spi_test_slave_block_rx);
+	saved_psr = HAL_disable_interrupts();
+	PLIC_SetPriority(CORESPI_SLAVE_IRQn, 3);
+	PLIC_EnableIRQ(CORESPI_SLAVE_IRQn);
+	HAL_restore_interrupts(saved_psr);
+
+	uart_printf("\n\r\t%5s %9s %9s %6s %6s %5s %8s\n\r", "gap", "frames/s", "SCLK", "frames",
+				"errors", "ovf", "isr/frm");
+
+	for(i = 0; i < sizeof(spi_slave_gaps) / sizeof(spi_slave_gaps[0]); i++)
+	{
+		memset(slaveRx, 0, sizeof(slaveRx));
+		saved_psr = HAL_disable_interrupts();
+		slave_block_done = 0;
+		slave_block_size = 0;
+		slave_isr_count = 0;
+		slave_isr_cycles = 0;
+		overflows = riscv_spi_slave.rx_overflow_count;
+		HAL_restore_interrupts(saved_psr);
+
+		start = get_cycle_count();
+		if(spi_slave_gaps[i] == 0)
+		{
+			SPI_set_slave_select(external_spi_1.spi, external_spi_1.spi_sel);
+			SPI_transfer_duplex(external_spi_1.spi, masterTx, NULL, SPI_SLAVE_TEST_FRAMES);
+			SPI_clear_slave_select(external_spi_1.spi, external_spi_1.spi_sel);
+		}
+		else
+		{
+			// One frame per descriptor, the slave kept selected until the last
+			for(frame = 0; frame < SPI_SLAVE_TEST_FRAMES; frame++)
+			{
+				uint32_t frameStart = get_cycle_count();
+
+				spi_test_desc_read(&desc, &external_spi_1, &masterTx[frame], NULL, 0);
+				if(frame < SPI_SLAVE_TEST_FRAMES - 1u)
+					desc.flags = SPI_DESC_KEEP_SELECTED;
+				SPI_transfer_queue(external_spi_1.spi, &desc, 1);
+
+				while(get_cycle_count() - frameStart < spi_slave_gaps[i])
+					;
+			}
+		}
+		elapsed = get_cycle_count() - start;
+
+		start = get_cycle_count();
+		while(slave_block_done == 0 && get_cycle_count() - start < SPI_SLAVE_TIMEOUT_CYCLES)
+			;
+		timedOut = (slave_block_done == 0);
+
+		mismatches = 0;
+		for(frame = 0; frame < SPI_SLAVE_TEST_FRAMES; frame++)
+		{
+			if(slaveRx[frame] != masterTx[frame])
+				mismatches++;
+		}
+		overflows = riscv_spi_slave.rx_overflow_count - overflows;
+		isrCycles = slave_isr_count ? slave_isr_cycles / SPI_SLAVE_TEST_FRAMES : 0;
+		frameRate = (uint32_t)(((uint64_t)SPI_SLAVE_TEST_FRAMES * SYS_CLK_FREQ) / elapsed);
+
+		uart_printf("\t%5u %9u %9u %6u %6u %5u %8u%s\n\r", spi_slave_gaps[i], frameRate, frameRate * 8u,
+					slave_block_size, mismatches, overflows, isrCycles, timedOut ? " no SSEND" : "");
+
+		if(!timedOut && mismatches == 0 && overflows == 0 && slave_block_size == SPI_SLAVE_TEST_FRAMES)
+			fastestRate = frameRate;
+	}
+
+	saved_psr = HAL_disable_interrupts();
+	PLIC_DisableIRQ(CORESPI_SLAVE_IRQn);
+	HAL_restore_interrupts(saved_psr);
+
+	// Reconfiguring as a slave clears the CTRL2 interrupt enables and flushes 
+	// the FIFOs without ever driving the bus, then the core is switched off 
+	// so it can't answer the real master's later transfers
+	SPI_configure_slave_mode(&riscv_spi_slave);
+	SPI_disable(&riscv_spi_slave);
+
+	if(fastestRate)
+		uart_printf("\tFastest clean rate: %u frames/s (%u Hz SCLK back to back)\n\r", fastestRate,
+					fastestRate * 8u);
+	else
+		UART_polled_tx_string(&g_uart, (const uint8_t *)"\tNo clean rate, check the EXTERNAL_SPI_1 wiring\n\r");
+}
+
+/**
+ * @brief	Block handler of the slave CoreSPI, called from "SPI_isr()" 
+ * 			when slave select is released
+ */
+static void spi_test_slave_block_rx(uint8_t *rx_buff, uint32_t rx_size)
+{
+	(void)rx_buff;
+	slave_block_size = rx_size;
+	slave_block_done = 1;
+}
+
+/**
+ * @brief	Interrupt handler for the slave CoreSPI. Counts the cycles 
+ * 			spent in "SPI_isr()".
+ */
+uint8_t External_8_IRQHandler(void)
+{
+	uint32_t start = get_cycle_count();
+
+	SPI_isr(&riscv_spi_slave);
+	slave_isr_cycles += get_cycle_count() - start;
+	slave_isr_count++;
+	return (EXT_IRQ_KEEP_ENABLED);
 }
 
 /**
@@ -630,14 +1332,21 @@ void spi_test_read_custom_byte(void)
  */
 void spi_test_display_commands(void)
 {
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tCOMMANDS:\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t- 0\t change selected device\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t- 1\t display selected device\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t- 2\t send write command\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t- 3\t send read command\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t- h\t display these commands\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t- d\t display SPI device IDs\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t- q\t exit SPI Test Program\n\r");
+	TLOG0("\tCOMMANDS:\n\r"
+	      "\t- 0\t change selected device\n\r"
+	      "\t- 1\t display selected device\n\r"
+	      "\t- 2\t send write command\n\r"
+	      "\t- 3\t send read command\n\r"
+	      "\t- 4\t compare polled and interrupt-driven reads\n\r"
+	      "\t- 5\t compare single and queued reads of FRAM, ADC and accelerometer\n\r"
+	      "\t- 6\t FRAM read/write bandwidth\n\r"
+	      "\t- 7\t SPI throughput sweep (loopback on an external port)\n\r"
+	      "\t- 8\t slave CoreSPI on EXTERNAL_SPI_1, fastest frame rate and ISR cost\n\r"
+	      "\t- 9\t compare SPI_transfer_block() and its fast path (loopback on an external port)\n\r"
+	      "\t- p\t display buffer pool usage\n\r"
+	      "\t- h\t display these commands\n\r"
+	      "\t- d\t display SPI device IDs\n\r"
+	      "\t- q\t exit SPI Test Program\n\r");
 }
 
 /**
@@ -645,13 +1354,13 @@ void spi_test_display_commands(void)
  */
 void spi_test_display_devices(void)
 {
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tSPI DEVICE IDs:\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t-(0) FRAM\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t-(1) EXTERNAL_SPI_0\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t-(2) EXTERNAL_SPI_1\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t-(3) ADC\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t-(4) LCD_SCREEN\n\r");
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t-(5) ACCELEROMETER\n\r");
+	TLOG0("\tSPI DEVICE IDs:\n\r"
+	      "\t-(0) FRAM\n\r"
+	      "\t-(1) EXTERNAL_SPI_0\n\r"
+	      "\t-(2) EXTERNAL_SPI_1\n\r"
+	      "\t-(3) ADC\n\r"
+	      "\t-(4) LCD_SCREEN\n\r"
+	      "\t-(5) ACCELEROMETER\n\r");
 }
 
 /**
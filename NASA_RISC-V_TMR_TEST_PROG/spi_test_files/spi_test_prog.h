@@ -12,10 +12,46 @@
 
 #include <string.h>
 #include <stdlib.h>
+#include "riscv_hal.h"
+#include "hal.h"
 #include "hw_platform.h"
 #include "core_uart_apb.h"
 #include "core_spi.h"
 #include "user_handler.h"
+#include "cycle_count.h"
+
+/**
+ * @brief	Bytes read by each transfer of the polled vs interrupt-driven
+ * 			comparison, "spi_test_async_compare()"
+ */
+#define SPI_ASYNC_TEST_SIZE		128u
+
+/** @brief Bytes read from each device by "spi_test_queue_compare()" */
+#define SPI_QUEUE_TEST_SIZE		4u
+
+/** @brief Polling rounds timed by "spi_test_queue_compare()" */
+#define SPI_QUEUE_TEST_ROUNDS	100u
+
+/** @brief Devices polled by "spi_test_queue_compare()" */
+#define SPI_QUEUE_TEST_DEVICES	3u
+
+/** @brief Largest transfer of the "spi_test_throughput_sweep()" */
+#define SPI_BENCH_MAX_SIZE		4096u
+
+/**
+ * @brief	Bytes sent at each size of the sweep. Small transfers are
+ * 			repeated until this many bytes have gone out.
+ */
+#define SPI_BENCH_TOTAL_BYTES	4096u
+
+/** @brief Transfers timed at each size by "spi_test_fast_path_compare()" */
+#define SPI_FAST_TEST_REPEATS	16u
+
+/** @brief Frames sent to the slave at each rate of "spi_test_slave_loopback()" */
+#define SPI_SLAVE_TEST_FRAMES	256u
+
+/** @brief Time allowed for the slave to report the end of a block */
+#define SPI_SLAVE_TIMEOUT_CYCLES	(SYS_CLK_FREQ / 10u)
 
 /**
  * @brief	Structure used to store SPI device configurations
@@ -39,6 +75,19 @@ typedef enum {
 	ACCELEROMETER
 } SPI_DEVICE_ID;
 
+/**
+ * @brief	FIFO fill strategies compared by "spi_test_throughput_sweep()"
+ */
+typedef enum {
+	SPI_FILL_FRAME,			/**< One frame in flight at a time */
+	SPI_FILL_HALF_FIFO,		/**< Up to half the FIFO in flight */
+	SPI_FILL_FULL_FIFO,		/**< "SPI_transfer_block()" as it is */
+	SPI_FILL_QUEUED,		/**< "SPI_transfer_queue()", full FIFO */
+	SPI_FILL_DUPLEX,		/**< "SPI_transfer_duplex()", full FIFO */
+	SPI_FILL_FAST,			/**< "SPI_transfer_block_fast()", full FIFO */
+	NUM_SPI_FILL
+} SPI_FILL;
+
 /**
  * @brief	List of different commands the user can perform
  */
@@ -76,6 +125,16 @@ extern spi_dev accelerometer_dev;
 void spi_test_init(void);
 void spi_test_read(spi_dev *device, uint8_t *command, uint8_t *data, uint8_t data_size);
 void spi_test_write(spi_dev *device, uint8_t *data, uint8_t data_size, uint8_t *resp_data);
+uint8_t spi_test_read_async(spi_dev *device, uint8_t *command, uint8_t *data, uint16_t data_size);
+uint8_t spi_test_async_busy(void);
+void spi_test_async_compare(void);
+void spi_test_desc_read(spi_block_desc_t *desc, spi_dev *device, uint8_t *command, uint8_t *data,
+						uint16_t data_size);
+void spi_test_queue_compare(void);
+void spi_test_fram_benchmark(void);
+void spi_test_throughput_sweep(void);
+void spi_test_slave_loopback(void);
+void spi_test_fast_path_compare(void);
 void spi_test_handler(void);
 void spi_test_send_write_command(void);
 void spi_test_send_read_command(void);
@@ -0,0 +1,205 @@
+/**
+ * @file 	prbs.c
+ * @author	Zac Carico
+ * @date 	Oct 16 2026
+ *
+ * @brief	Function definitions of prbs.h
+ */
+
+#include "prbs.h"
+
+/** @brief Order and tap of each PRBS_TYPE, x^order + x^tap + 1 */
+static const uint8_t prbs_polynomials[NUM_PRBS_TYPES][2] = {
+	{7, 6},
+	{15, 14},
+	{31, 28}
+};
+
+/** @brief Each nibble value with its bits in reverse order */
+static const uint8_t nibble_reverse[16] = {
+	0x0, 0x8, 0x4, 0xC, 0x2, 0xA, 0x6, 0xE,
+	0x1, 0x9, 0x5, 0xD, 0x3, 0xB, 0x7, 0xF
+};
+
+static uint8_t reverse_bits(uint8_t value);
+
+/**
+ * @brief	Counts the bits set in a byte, used to turn the XOR of a sent
+ * 			and received byte into a number of bit errors
+ *
+ * @param value	Byte to count
+ *
+ * @return	Number of bits set, 0 to 8
+ */
+uint8_t count_bits(uint8_t value)
+{
+	uint8_t count = 0;
+
+	while(value != 0)
+	{
+		value &= (uint8_t)(value - 1u);
+		count++;
+	}
+
+	return count;
+}
+
+/**
+ * @brief	Starts a generator at the all ones state
+ *
+ * @param gen	Generator to start
+ * @param type	Sequence to generate
+ */
+void prbs_init(prbs_gen_t *gen, PRBS_TYPE type)
+{
+	gen->order = prbs_polynomials[type][0];
+	gen->tap = prbs_polynomials[type][1];
+	gen->mask = (uint32_t)((1uLL << gen->order) - 1u);
+	gen->state = gen->mask;
+}
+
+/**
+ * @brief	Returns the next 8 bits of a generator's sequence
+ *
+ * @details	When the tap is at least 8 none of the next 8 bits depends on 
+ * 			another of them, so they are all worked out with one shift and 
+ * 			XOR of the state. The first bit comes out in bit 7 and ends up 
+ * 			in bit 0 once reversed. PRBS-7 is stepped a bit at a time.
+ *
+ * @param gen	Generator, updated
+ *
+ * @return	Next byte of the sequence, first bit in bit 0
+ */
+uint8_t prbs_next_byte(prbs_gen_t *gen)
+{
+	uint32_t lfsr = gen->state;
+	uint32_t bits = 0;
+	uint8_t i;
+
+	if(gen->tap >= 8)
+	{
+		bits = ((lfsr >> (gen->order - 8u)) ^ (lfsr >> (gen->tap - 8u))) & 0xFFu;
+		gen->state = ((lfsr << 8) | bits) & gen->mask;
+		return reverse_bits((uint8_t)bits);
+	}
+
+	for(i = 0; i < 8; i++)
+	{
+		uint32_t bit = ((lfsr >> (gen->order - 1u)) ^ (lfsr >> (gen->tap - 1u))) & 1u;
+		lfsr = ((lfsr << 1) | bit) & gen->mask;
+		bits |= bit << i;
+	}
+
+	gen->state = lfsr;
+	return (uint8_t)bits;
+}
+
+/**
+ * @brief	Fills a buffer with the next bytes of a generator's sequence
+ *
+ * @param gen		Generator, updated
+ * @param buf		Buffer to fill
+ * @param length	Number of bytes to write to buf
+ */
+void prbs_fill(prbs_gen_t *gen, uint8_t *buf, uint32_t length)
+{
+	uint32_t i;
+
+	for(i = 0; i < length; i++)
+		buf[i] = prbs_next_byte(gen);
+}
+
+/**
+ * @brief	Clears a checker's counters and makes it synchronize to the 
+ * 			next bytes checked
+ *
+ * @param checker	Checker to start
+ * @param type		Sequence expected
+ */
+void prbs_checker_init(prbs_checker_t *checker, PRBS_TYPE type)
+{
+	prbs_init(&checker->ref, type);
+	checker->locked = 0;
+	checker->syncBytes = 0;
+	checker->errorRun = 0;
+	checker->burstBits = 0;
+	checker->maxBurstBits = 0;
+	checker->syncLosses = 0;
+	checker->bytesChecked = 0;
+	checker->bytesUnchecked = 0;
+	checker->bitErrors = 0;
+}
+
+/**
+ * @brief	Checks the next chunk of a received stream, in any size of 
+ * 			chunk, without keeping any of it
+ *
+ * @details	While synchronizing, each received byte is shifted into the 
+ * 			checker's state the same way the generator would have shifted 
+ * 			it in, so once "order" bits have been loaded the state matches 
+ * 			the sender's. Those bytes are counted as unchecked. A state of 
+ * 			zero, as from an idle or broken line, is not accepted.
+ *
+ * @param checker	Checker, updated
+ * @param buf		Received bytes
+ * @param length	Number of bytes in buf
+ */
+void prbs_check(prbs_checker_t *checker, const uint8_t *buf, uint32_t length)
+{
+	uint32_t i;
+	uint8_t errors;
+
+	for(i = 0; i < length; i++)
+	{
+		if(checker->locked == 0)
+		{
+			checker->ref.state = ((checker->ref.state << 8) | reverse_bits(buf[i])) &
+								 checker->ref.mask;
+			checker->bytesUnchecked++;
+			if(checker->syncBytes < 4)
+				checker->syncBytes++;
+			if(checker->syncBytes * 8u >= checker->ref.order && checker->ref.state != 0)
+			{
+				checker->locked = 1;
+				checker->errorRun = 0;
+			}
+			continue;
+		}
+
+		errors = count_bits(buf[i] ^ prbs_next_byte(&checker->ref));
+		checker->bytesChecked++;
+		if(errors == 0)
+		{
+			if(checker->burstBits > checker->maxBurstBits)
+				checker->maxBurstBits = checker->burstBits;
+			checker->burstBits = 0;
+			checker->errorRun = 0;
+			continue;
+		}
+
+		checker->bitErrors += errors;
+		checker->burstBits += errors;
+		checker->errorRun++;
+		if(checker->errorRun >= PRBS_LOCK_LOSS_BYTES)
+		{
+			checker->locked = 0;
+			checker->syncBytes = 0;
+			checker->syncLosses++;
+		}
+	}
+
+	if(checker->burstBits > checker->maxBurstBits)
+		checker->maxBurstBits = checker->burstBits;
+}
+
+/**
+ * @brief	Reverses the order of the bits in a byte
+ *
+ * @param value	Byte to reverse
+ *
+ * @return	value with bit 0 in bit 7 and so on
+ */
+static uint8_t reverse_bits(uint8_t value)
+{
+	return (uint8_t)((nibble_reverse[value & 0x0Fu] << 4) | nibble_reverse[value >> 4]);
+}
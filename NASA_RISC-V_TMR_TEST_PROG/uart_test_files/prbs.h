@@ -0,0 +1,78 @@
+/**
+ * @file 	prbs.h
+ * @author	Zac Carico
+ * @date 	Oct 16 2026
+ *
+ * @brief	Header file containing all the prototypes and declarations
+ * 			for the PRBS test pattern generators and checker
+ *
+ * @details	PRBS-15 (x^15 + x^14 + 1) repeats every 32767 bits and
+ * 			contains every 15-bit pattern except all zeros, so it
+ * 			exercises long runs and every transition on a serial link.
+ * 			Bytes are taken 8 bits at a time, least significant bit first,
+ * 			in the order a UART sends them.
+ *
+ * 			prbs_gen_t generates PRBS-7 (x^7 + x^6 + 1), PRBS-15 or 
+ * 			PRBS-31 (x^31 + x^28 + 1), starting from the all ones state. 
+ * 			The sender and checker of a block each keep a generator, and 
+ * 			prbs_checker_t checks a stream chunk by chunk as it arrives.
+ * 			The checker needs no seed: it loads its state from the first
+ * 			received bytes, then compares every byte after that with its
+ * 			own copy of the sequence. PRBS_LOCK_LOSS_BYTES errored bytes
+ * 			in a row, as after a dropped byte, make it load its state again.
+ */
+
+#ifndef PRBS_H
+#define PRBS_H
+
+#include <stdint.h>
+
+/** @brief Errored bytes in a row after which "prbs_check()" resynchronizes */
+#define PRBS_LOCK_LOSS_BYTES	8u
+
+/**
+ * @brief	Sequences generated by prbs_gen_t
+ */
+typedef enum {
+	PRBS_7,
+	PRBS_15,
+	PRBS_31,
+	NUM_PRBS_TYPES
+} PRBS_TYPE;
+
+/**
+ * @brief	State of a PRBS generator, x^order + x^tap + 1
+ */
+typedef struct {
+	uint32_t state;
+	uint32_t mask;
+	uint8_t order;
+	uint8_t tap;
+} prbs_gen_t;
+
+/**
+ * @brief	State and counters of a PRBS stream checker. "burstBits" is 
+ * 			the number of bit errors in the current run of errored bytes 
+ * 			and "maxBurstBits" the largest such run so far.
+ */
+typedef struct {
+	prbs_gen_t ref;
+	uint8_t locked;
+	uint8_t syncBytes;
+	uint8_t errorRun;
+	uint32_t burstBits;
+	uint32_t maxBurstBits;
+	uint32_t syncLosses;
+	uint64_t bytesChecked;
+	uint64_t bytesUnchecked;
+	uint64_t bitErrors;
+} prbs_checker_t;
+
+uint8_t count_bits(uint8_t value);
+void prbs_init(prbs_gen_t *gen, PRBS_TYPE type);
+uint8_t prbs_next_byte(prbs_gen_t *gen);
+void prbs_fill(prbs_gen_t *gen, uint8_t *buf, uint32_t length);
+void prbs_checker_init(prbs_checker_t *checker, PRBS_TYPE type);
+void prbs_check(prbs_checker_t *checker, const uint8_t *buf, uint32_t length);
+
+#endif /*PRBS_H*/
@@ -0,0 +1,676 @@
+/**
+ * @file 	uart_test.c
+ * @author	Zac Carico
+ * @date 	Oct 16 2026
+ * 
+ * @brief	Function definitions of uart_test.h
+ */
+
+#include "uart_test.h"
+#include "tlog.h"
+#include "uart_printf.h"
+#include "prbs.h"
+
+/**
+ * @brief	Messages timed by "uart_test_tx_cycles()". They match the 
+ * 			kinds of strings the test programs print: a prompt, a single 
+ * 			menu line and a whole menu.
+ */
+static const char * const tx_cycle_messages[] = {
+	"\n\r\t> ",
+	"\t- 2\t send write command\n\r",
+	"\tCOMMANDS:\n\r"
+	"\t- 0\t change selected device\n\r"
+	"\t- 1\t display selected device\n\r"
+	"\t- 2\t send write command\n\r"
+	"\t- 3\t send read command\n\r"
+	"\t- h\t display these commands\n\r"
+	"\t- d\t display SPI device IDs\n\r"
+	"\t- q\t exit SPI Test Program\n\r"
+};
+
+#define NUM_TX_CYCLE_MESSAGES	(sizeof(tx_cycle_messages) / sizeof(tx_cycle_messages[0]))
+
+/** @brief Values printed by the call chains timed in "uart_test_printf_cycles()" */
+static const uint8_t printf_cycle_data[16] = {
+	0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+	0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF
+};
+
+static void chain_byte(void);
+static void printf_byte(void);
+static void chain_decimal(void);
+static void printf_decimal(void);
+static void chain_dump(void);
+static void printf_dump(void);
+
+/**
+ * @brief	Output timed by "uart_test_printf_cycles()", each printed 
+ * 			once with the call chains the test programs use and once 
+ * 			with "uart_printf()"
+ */
+static const struct {
+	const char *name;
+	void (*chain)(void);
+	void (*formatted)(void);
+} printf_cycle_cases[] = {
+	{"hex byte", chain_byte, printf_byte},
+	{"decimal", chain_decimal, printf_decimal},
+	{"16 byte dump", chain_dump, printf_dump}
+};
+
+#define NUM_PRINTF_CYCLE_CASES	(sizeof(printf_cycle_cases) / sizeof(printf_cycle_cases[0]))
+
+/**
+ * @brief	Ways "uart_test_prbs()" sends each block
+ */
+typedef enum {
+	PRBS_TX_SEND,
+	PRBS_TX_FILL_FIFO,
+	NUM_PRBS_TX_METHODS
+} PRBS_TX_METHOD;
+
+/**
+ * @brief	Results of one "uart_test_prbs()" pass
+ */
+typedef struct {
+	uint32_t blocks;
+	uint32_t bytesSent;
+	uint32_t bytesReceived;
+	uint32_t byteErrors;
+	uint32_t bitErrors;
+	uint32_t parityErrors;
+	uint32_t framingErrors;
+	uint32_t overflowErrors;
+	uint32_t totalCycles;
+	uint32_t txCycles;
+	uint32_t minLatency;
+	uint32_t maxLatency;
+	uint32_t latencyHistogram[PRBS_LATENCY_BUCKETS];
+} prbs_result_t;
+
+static void prbs_run_block(PRBS_TX_METHOD method, uint16_t length, prbs_gen_t *txGen,
+						   prbs_gen_t *rxGen, prbs_result_t *result);
+static void prbs_wait_rx_idle(void);
+static void prbs_display_result(const char *name, const prbs_result_t *result);
+static uint16_t irq_rate_format_line(char *line, uint16_t size, uint32_t seq);
+static void irq_rate_display_result(const char *name, uint32_t bytes,
+									uint32_t irqs, uint32_t cycles);
+
+/** @brief Block being sent and received by "uart_test_prbs()" */
+static uint8_t prbs_tx_block[PRBS_MAX_BLOCK];
+static uint8_t prbs_rx_block[PRBS_MAX_BLOCK];
+
+/**
+ * @brief	The main function of the UART test. Lets the user choose 
+ * 			which UART measurement to run.
+ */
+void uart_test_handler(void)
+{
+	uint8_t quit = 0;
+	char command = 0;
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\rWELCOME TO THE UART TEST!\n\r");
+	uart_test_display_commands();
+
+	while(quit == 0)
+	{
+		UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\r What would you like to do?\n\r");
+		command = get_single_char_from_user();
+		switch(command)
+		{
+			case 'h':
+				uart_test_display_commands();
+				break;
+			case 'q':
+				quit = 1;
+				break;
+			case '0':
+				uart_test_tx_cycles();
+				break;
+			case '1':
+				uart_test_printf_cycles();
+				break;
+			case '2':
+				uart_test_prbs();
+				break;
+			case '3':
+				uart_test_irq_rate();
+				break;
+			default:
+				uart_test_display_incorrect_command();
+				break;
+		}
+	}
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\rLeaving UART Test Program\n\r");
+}
+
+/**
+ * @brief	Measures how many cycles a caller of "UART_polled_tx_string()" 
+ * 			spends in the transmit path, with the polled loop and with the 
+ * 			interrupt-driven ring buffer.
+ * 
+ * @details	Each message is sent once with the ring buffer detached 
+ * 			(the caller waits on TXRDY for every byte) and once with it 
+ * 			attached (the caller only copies into the ring). The ring is 
+ * 			flushed between runs so each queued run starts empty.
+ */
+void uart_test_tx_cycles(void)
+{
+	uint32_t polled_cycles[NUM_TX_CYCLE_MESSAGES];
+	uint32_t queued_cycles[NUM_TX_CYCLE_MESSAGES];
+	uint32_t start = 0;
+	uint8_t i = 0;
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"Timing the transmit path, each message is printed twice...\n\r");
+
+	for(i = 0; i < NUM_TX_CYCLE_MESSAGES; i++)
+	{
+		UART_tx_flush(&g_uart);
+		UART_set_tx_ring_buffer(&g_uart, 0, 0);
+		start = get_cycle_count();
+		UART_polled_tx_string(&g_uart, (const uint8_t *)tx_cycle_messages[i]);
+		polled_cycles[i] = get_cycle_count() - start;
+
+		UART_set_tx_ring_buffer(&g_uart, g_uart_tx_ring, sizeof(g_uart_tx_ring));
+		start = get_cycle_count();
+		UART_polled_tx_string(&g_uart, (const uint8_t *)tx_cycle_messages[i]);
+		queued_cycles[i] = get_cycle_count() - start;
+	}
+	UART_tx_flush(&g_uart);
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\r\tBYTES\tPOLLED CYCLES\tQUEUED CYCLES\n\r");
+	for(i = 0; i < NUM_TX_CYCLE_MESSAGES; i++)
+	{
+		uart_printf("\t%u\t%u\t\t%u\n\r", strlen(tx_cycle_messages[i]),
+					polled_cycles[i], queued_cycles[i]);
+	}
+}
+
+/**
+ * @brief	Measures the cycles spent printing a value with the call 
+ * 			chains the test programs use ("int_to_*_string()" followed 
+ * 			by several "UART_polled_tx_string()" calls) and with a single 
+ * 			"uart_printf()" call.
+ * 
+ * @details	Every case is timed with the transmit ring buffer detached, 
+ * 			where each call polls TXRDY for its bytes, and attached, where 
+ * 			each call only copies into the ring. The ring is flushed before 
+ * 			every run so each one starts empty.
+ */
+void uart_test_printf_cycles(void)
+{
+	uint32_t cycles[NUM_PRINTF_CYCLE_CASES][4];
+	uint32_t start = 0;
+	uint8_t i = 0;
+	uint8_t queued = 0;
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"Timing formatted output, each value is printed four times...\n\r");
+
+	for(i = 0; i < NUM_PRINTF_CYCLE_CASES; i++)
+	{
+		for(queued = 0; queued < 2; queued++)
+		{
+			UART_tx_flush(&g_uart);
+			if(queued)
+				UART_set_tx_ring_buffer(&g_uart, g_uart_tx_ring, sizeof(g_uart_tx_ring));
+			else
+				UART_set_tx_ring_buffer(&g_uart, 0, 0);
+
+			start = get_cycle_count();
+			printf_cycle_cases[i].chain();
+			cycles[i][queued * 2] = get_cycle_count() - start;
+
+			UART_tx_flush(&g_uart);
+			start = get_cycle_count();
+			printf_cycle_cases[i].formatted();
+			cycles[i][queued * 2 + 1] = get_cycle_count() - start;
+		}
+	}
+	UART_tx_flush(&g_uart);
+
+	uart_printf("\n\r\t%-14s%-14s%-14s%-14s%s\n\r", "OUTPUT", "POLLED CHAIN",
+				"POLLED PRINTF", "QUEUED CHAIN", "QUEUED PRINTF");
+	for(i = 0; i < NUM_PRINTF_CYCLE_CASES; i++)
+	{
+		uart_printf("\t%-14s%-14u%-14u%-14u%u\n\r", printf_cycle_cases[i].name,
+					cycles[i][0], cycles[i][1], cycles[i][2], cycles[i][3]);
+	}
+}
+
+/**
+ * @brief	Sends PRBS-15 blocks through an external loopback or a host 
+ * 			echo and checks what comes back, measuring throughput, the 
+ * 			round trip latency of each block and receive errors.
+ * 
+ * @details	The console is g_uart, so the test runs in three steps: 
+ * 			"PRBS START" is printed, then the test data is exchanged, 
+ * 			then the results are printed once the link has gone quiet. 
+ * 			tools/uart_echo.py acts as the terminal and echoes only the 
+ * 			test data. With a loopback the terminal sees nothing until 
+ * 			the loopback is removed.
+ * 
+ * 			Every block is run twice, once sent with "UART_send()", which 
+ * 			polls TXRDY for every byte, and once with "UART_fill_tx_fifo()" 
+ * 			batches interleaved with reading the echo. While the test runs 
+ * 			the ring buffers are put in raw mode and the command protocol 
+ * 			handler is detached so every byte is seen as data.
+ */
+void uart_test_prbs(void)
+{
+	static prbs_result_t results[NUM_PRBS_TX_METHODS];
+	uart_rx_handler_t savedHandler;
+	uint16_t length = 0;
+	uint32_t numBlocks = 0;
+	prbs_gen_t txGen;
+	prbs_gen_t rxGen;
+	uint32_t block = 0;
+	uint8_t method = 0;
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tBlock length in bytes (1-256):\n\r");
+	length = (uint16_t)get_dec_from_user(3);
+	if(length == 0 || length > PRBS_MAX_BLOCK)
+		length = PRBS_MAX_BLOCK;
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tNumber of blocks (1-9999):\n\r");
+	numBlocks = get_dec_from_user(4);
+	if(numBlocks == 0)
+		numBlocks = 1;
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tConnect the loopback or start tools/uart_echo.py, then press any key\n\r");
+	(void)get_single_char_from_user();
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"PRBS START\n\r");
+
+	// Give the host time to switch to echoing before any data is sent
+	UART_tx_flush(&g_uart);
+	prbs_wait_rx_idle();
+
+	savedHandler = g_uart.rx_handler;
+	UART_set_rx_handler(&g_uart, 0);
+	UART_set_tx_ring_buffer(&g_uart, 0, 0);
+	UART_set_rx_ring_buffer(&g_uart, g_uart_rx_ring, sizeof(g_uart_rx_ring), UART_RX_RAW);
+	(void)UART_get_rx_status(&g_uart);
+
+	prbs_init(&txGen, PRBS_15);
+	prbs_init(&rxGen, PRBS_15);
+	memset(results, 0, sizeof(results));
+	for(method = 0; method < NUM_PRBS_TX_METHODS; method++)
+		results[method].minLatency = 0xFFFFFFFFu;
+
+	for(block = 0; block < numBlocks; block++)
+	{
+		for(method = 0; method < NUM_PRBS_TX_METHODS; method++)
+			prbs_run_block((PRBS_TX_METHOD)method, length, &txGen, &rxGen, &results[method]);
+	}
+
+	// Let any late echo arrive before the console goes back to line mode
+	prbs_wait_rx_idle();
+	UART_set_rx_ring_buffer(&g_uart, g_uart_rx_ring, sizeof(g_uart_rx_ring),
+							UART_RX_LINE_EDIT | UART_RX_ECHO);
+	UART_set_tx_ring_buffer(&g_uart, g_uart_tx_ring, sizeof(g_uart_tx_ring));
+	UART_set_rx_handler(&g_uart, savedHandler);
+
+	uart_printf("\n\r\tPRBS-15, %u blocks of %u bytes for each transmit method\n\r",
+				numBlocks, length);
+	prbs_display_result("UART_send()", &results[PRBS_TX_SEND]);
+	prbs_display_result("UART_fill_tx_fifo()", &results[PRBS_TX_FILL_FIFO]);
+}
+
+/**
+ * @brief	Streams IRQ_RATE_STREAM_BYTES of telemetry lines through the 
+ * 			transmit ring buffer of g_uart and of g_uart_16550 and compares 
+ * 			the interrupts taken per kilobyte.
+ * 
+ * @details	CoreUARTapb has a single holding register, so TXRDY is taken 
+ * 			once per byte, while Core16550 refills its 16 byte FIFO on 
+ * 			each interrupt. The ring buffers are left to drain from their 
+ * 			interrupts rather than "*_tx_flush()", which would empty them 
+ * 			from the caller and hide the interrupts being counted. The 
+ * 			g_uart lines appear on the console. g_uart_16550 is put in 
+ * 			loopback with its receive ring detached so only transmit 
+ * 			interrupts are counted and nothing leaves the pins.
+ */
+void uart_test_irq_rate(void)
+{
+	char line[64];
+	uint16_t lineLength = 0;
+	uint32_t bytes = 0;
+	uint32_t seq = 0;
+	uint32_t irqStart = 0;
+	uint32_t start = 0;
+	uint32_t apbIrqs = 0;
+	uint32_t apbCycles = 0;
+	uint32_t apbBytes = 0;
+	uint8_t discard[16];
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"Streaming telemetry through CoreUARTapb...\n\r");
+	UART_tx_flush(&g_uart);
+
+	irqStart = g_uart_tx_irq_count;
+	start = get_cycle_count();
+	for(bytes = 0, seq = 0; bytes < IRQ_RATE_STREAM_BYTES; bytes += lineLength, seq++)
+	{
+		lineLength = irq_rate_format_line(line, sizeof(line), seq);
+		UART_send(&g_uart, (const uint8_t *)line, lineLength);
+	}
+	while(UART_get_tx_pending(&g_uart) > 0)
+		;
+	apbCycles = get_cycle_count() - start;
+	apbIrqs = g_uart_tx_irq_count - irqStart;
+	apbBytes = bytes;
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\rStreaming telemetry through Core16550 in loopback...\n\r");
+	UART_tx_flush(&g_uart);
+
+	UART_16550_tx_flush(&g_uart_16550);
+	UART_16550_set_rx_ring_buffer(&g_uart_16550, 0, 0, UART_16550_FIFO_EIGHT_BYTES);
+	UART_16550_set_loopback(&g_uart_16550, 1);
+
+	irqStart = g_uart_16550_irq_count;
+	start = get_cycle_count();
+	for(bytes = 0, seq = 0; bytes < IRQ_RATE_STREAM_BYTES; bytes += lineLength, seq++)
+	{
+		lineLength = irq_rate_format_line(line, sizeof(line), seq);
+		UART_16550_polled_tx(&g_uart_16550, (const uint8_t *)line, lineLength);
+	}
+	while(UART_16550_get_tx_pending(&g_uart_16550) > 0)
+		;
+	irq_rate_display_result("CoreUARTapb", apbBytes, apbIrqs, apbCycles);
+	irq_rate_display_result("Core16550", bytes, g_uart_16550_irq_count - irqStart,
+							get_cycle_count() - start);
+
+	// The looped back bytes overran the receive FIFO, throw them away
+	UART_16550_set_rx_ring_buffer(&g_uart_16550, g_uart_16550_rx_ring,
+								  sizeof(g_uart_16550_rx_ring), UART_16550_FIFO_EIGHT_BYTES);
+	while(UART_16550_get_rx(&g_uart_16550, discard, sizeof(discard)) > 0)
+		;
+	UART_16550_set_loopback(&g_uart_16550, 0);
+	(void)UART_16550_get_rx_status(&g_uart_16550);
+}
+
+/**
+ * @brief	Displays the user commands for the program
+ */
+void uart_test_display_commands(void)
+{
+	TLOG0("\tCOMMANDS:\n\r"
+	      "\t- 0\t compare polled and queued transmit cycles\n\r"
+	      "\t- 1\t compare call chain and uart_printf cycles\n\r"
+	      "\t- 2\t PRBS throughput and error rate through a loopback or host echo\n\r"
+	      "\t- 3\t compare CoreUARTapb and Core16550 interrupts per KB\n\r"
+	      "\t- h\t display these commands\n\r"
+	      "\t- q\t exit UART Test Program\n\r");
+}
+
+/**
+ * @brief	Displays when user enters an invalid command
+ */
+void uart_test_display_incorrect_command(void)
+{
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"ERROR! Invalid Command!\n\r");
+}
+
+/**
+ * @brief	Prints a byte the way "spi_test_write_single_byte()" used to
+ */
+static void chain_byte(void)
+{
+	char hexStr[5];
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tResponse was \"");
+	int_to_single_byte_string(printf_cycle_data[5], hexStr);
+	UART_polled_tx_string(&g_uart, (const uint8_t *)hexStr);
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\"\n\r");
+}
+
+/**
+ * @brief	Prints the same output as "chain_byte()" with one call
+ */
+static void printf_byte(void)
+{
+	uart_printf("\tResponse was \"0x%02X\"\n\r", printf_cycle_data[5]);
+}
+
+/**
+ * @brief	Prints a decimal value the way "uart_test_tx_cycles()" used to
+ */
+static void chain_decimal(void)
+{
+	char decStr[11];
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tCycles: ");
+	int_to_dec_string((uint32_t)SYS_CLK_FREQ, decStr);
+	UART_polled_tx_string(&g_uart, (const uint8_t *)decStr);
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\r");
+}
+
+/**
+ * @brief	Prints the same output as "chain_decimal()" with one call
+ */
+static void printf_decimal(void)
+{
+	uart_printf("\tCycles: %u\n\r", (uint32_t)SYS_CLK_FREQ);
+}
+
+/**
+ * @brief	Prints a buffer one byte at a time, as the SPI test does 
+ * 			with read data
+ */
+static void chain_dump(void)
+{
+	char hexStr[5];
+	uint8_t i;
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\tData:");
+	for(i = 0; i < sizeof(printf_cycle_data); i++)
+	{
+		UART_polled_tx_string(&g_uart, (const uint8_t *)" ");
+		int_to_single_byte_string(printf_cycle_data[i], hexStr);
+		UART_polled_tx_string(&g_uart, (const uint8_t *)&hexStr[2]);
+	}
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\r");
+}
+
+/**
+ * @brief	Prints the same output as "chain_dump()" with one call
+ */
+static void printf_dump(void)
+{
+	uart_printf("\tData: %B\n\r", printf_cycle_data, sizeof(printf_cycle_data));
+}
+
+/**
+ * @brief	Sends one PRBS block, waits for its echo and adds the outcome 
+ * 			to result
+ * 
+ * @details	Bytes that don't come back within PRBS_TIMEOUT_CYCLES of the 
+ * 			last byte received are counted as lost. Lost bytes are counted 
+ * 			as byte errors along with bytes that came back changed.
+ * 
+ * @param method	How the block is sent
+ * @param length	Number of bytes in the block
+ * @param txGen	PRBS generator of the sender, updated
+ * @param rxGen	PRBS generator of the checker, updated
+ * @param result	Pass the block belongs to
+ */
+static void prbs_run_block(PRBS_TX_METHOD method, uint16_t length, prbs_gen_t *txGen,
+						   prbs_gen_t *rxGen, prbs_result_t *result)
+{
+	uint32_t start = 0;
+	uint32_t lastRx = 0;
+	uint32_t now = 0;
+	uint32_t latency = 0;
+	uint16_t sent = 0;
+	uint16_t received = 0;
+	uint16_t count = 0;
+	uint16_t i = 0;
+	uint8_t status = 0;
+	uint8_t bucket = 0;
+
+	prbs_fill(txGen, prbs_tx_block, length);
+
+	start = get_cycle_count();
+	lastRx = start;
+	if(method == PRBS_TX_SEND)
+	{
+		UART_send(&g_uart, prbs_tx_block, length);
+		sent = length;
+		result->txCycles += get_cycle_count() - start;
+	}
+
+	while(received < length)
+	{
+		if(sent < length)
+		{
+			now = get_cycle_count();
+			sent += (uint16_t)UART_fill_tx_fifo(&g_uart, &prbs_tx_block[sent], length - sent);
+			result->txCycles += get_cycle_count() - now;
+		}
+
+		now = get_cycle_count();
+		count = (uint16_t)UART_get_rx(&g_uart, &prbs_rx_block[received], length - received);
+		if(count > 0)
+		{
+			received += count;
+			lastRx = now;
+		}
+		else if(now - lastRx > PRBS_TIMEOUT_CYCLES)
+		{
+			break;
+		}
+	}
+	now = get_cycle_count();
+
+	// Compare against the sequence regenerated by the checker's generator
+	for(i = 0; i < length; i++)
+	{
+		uint8_t expected = prbs_next_byte(rxGen);
+		if(i >= received)
+		{
+			result->byteErrors++;
+		}
+		else if(prbs_rx_block[i] != expected)
+		{
+			result->byteErrors++;
+			result->bitErrors += count_bits((uint8_t)(prbs_rx_block[i] ^ expected));
+		}
+	}
+
+	status = UART_get_rx_status(&g_uart);
+	if(status & UART_APB_PARITY_ERROR)
+		result->parityErrors++;
+	if(status & UART_APB_FRAMING_ERROR)
+		result->framingErrors++;
+	if(status & UART_APB_OVERFLOW_ERROR)
+		result->overflowErrors++;
+
+	latency = now - start;
+	result->blocks++;
+	result->bytesSent += length;
+	result->bytesReceived += received;
+	result->totalCycles += latency;
+	if(latency < result->minLatency)
+		result->minLatency = latency;
+	if(latency > result->maxLatency)
+		result->maxLatency = latency;
+
+	// Bucket 0 is under PRBS_LATENCY_FIRST_US, each bucket after it doubles
+	latency /= (SYS_CLK_FREQ / 1000000u);
+	while(bucket < PRBS_LATENCY_BUCKETS - 1u && latency >= (PRBS_LATENCY_FIRST_US << bucket))
+		bucket++;
+	result->latencyHistogram[bucket]++;
+}
+
+/**
+ * @brief	Reads and throws away received bytes until the receiver has 
+ * 			been quiet for PRBS_IDLE_CYCLES
+ */
+static void prbs_wait_rx_idle(void)
+{
+	uint8_t discard[16];
+	uint32_t lastRx = get_cycle_count();
+
+	while(get_cycle_count() - lastRx < PRBS_IDLE_CYCLES)
+	{
+		if(UART_get_rx(&g_uart, discard, sizeof(discard)) > 0)
+			lastRx = get_cycle_count();
+	}
+}
+
+/**
+ * @brief	Prints the results of one "uart_test_prbs()" pass
+ * 
+ * @param name		Transmit method of the pass
+ * @param result	Results of the pass
+ */
+static void prbs_display_result(const char *name, const prbs_result_t *result)
+{
+	uint32_t bytesPerSec = 0;
+	uint32_t txCyclesPerByte = 0;
+	uint32_t usPerCycle = SYS_CLK_FREQ / 1000000u;
+	uint8_t bucket = 0;
+
+	if(result->totalCycles > 0)
+		bytesPerSec = (uint32_t)(((uint64_t)result->bytesReceived * SYS_CLK_FREQ) / result->totalCycles);
+	if(result->bytesSent > 0)
+		txCyclesPerByte = result->txCycles / result->bytesSent;
+
+	uart_printf("\n\r\t%s\n\r"
+				"\t  bytes sent/received: %u/%u, %u bytes/s\n\r"
+				"\t  transmit CPU cycles per byte: %u\n\r"
+				"\t  byte errors: %u, bit errors: %u\n\r"
+				"\t  parity: %u, framing: %u, overflow: %u blocks\n\r",
+				name, result->bytesSent, result->bytesReceived, bytesPerSec,
+				txCyclesPerByte, result->byteErrors, result->bitErrors,
+				result->parityErrors, result->framingErrors, result->overflowErrors);
+
+	if(result->blocks == 0)
+		return;
+
+	uart_printf("\t  block round trip: min %u us, max %u us, mean %u us\n\r",
+				result->minLatency / usPerCycle, result->maxLatency / usPerCycle,
+				result->totalCycles / result->blocks / usPerCycle);
+	for(bucket = 0; bucket < PRBS_LATENCY_BUCKETS; bucket++)
+	{
+		if(bucket < PRBS_LATENCY_BUCKETS - 1u)
+			uart_printf("\t    < %6u us: %u\n\r", PRBS_LATENCY_FIRST_US << bucket,
+						result->latencyHistogram[bucket]);
+		else
+			uart_printf("\t   >= %6u us: %u\n\r", PRBS_LATENCY_FIRST_US << (bucket - 1u),
+						result->latencyHistogram[bucket]);
+	}
+}
+
+/**
+ * @brief	Formats one telemetry line streamed by "uart_test_irq_rate()"
+ * 
+ * @param line	Buffer for the line
+ * @param size	Size of line
+ * @param seq	Sequence number of the line
+ * 
+ * @return	Length of the line
+ */
+static uint16_t irq_rate_format_line(char *line, uint16_t size, uint32_t seq)
+{
+	return uart_snprintf(line, size, "TLM %5u t=%10u adc=%04X temp=%4d\n\r",
+						 seq, get_cycle_count(), (seq * 37u) & 0x0FFFu,
+						 (int32_t)(seq % 200u) - 100);
+}
+
+/**
+ * @brief	Prints the results of one "uart_test_irq_rate()" stream
+ * 
+ * @param name		UART the lines were streamed through
+ * @param bytes		Bytes streamed
+ * @param irqs		Interrupts taken while streaming
+ * @param cycles	Cycles from the first line to the ring buffer emptying
+ */
+static void irq_rate_display_result(const char *name, uint32_t bytes,
+									uint32_t irqs, uint32_t cycles)
+{
+	uart_printf("\n\r\t%s\n\r"
+				"\t  bytes: %u, interrupts: %u, interrupts per KB: %u\n\r"
+				"\t  cycles: %u\n\r",
+				name, bytes, irqs, (uint32_t)(((uint64_t)irqs * 1024u) / bytes), cycles);
+}
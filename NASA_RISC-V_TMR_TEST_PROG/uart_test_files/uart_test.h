@@ -0,0 +1,103 @@
+/**
+ * @file 	uart_test.h
+ * @author	Zac Carico
+ * @date 	Oct 16 2026
+ * 
+ * @brief	Header file containing all the prototypes 
+ * 			and declarations for the UART test
+ */
+
+#ifndef UART_TEST_H
+#define UART_TEST_H
+
+#include <stdint.h>
+#include <string.h>
+#include "hw_platform.h"
+#include "core_uart_apb.h"
+#include "core_16550.h"
+#include "user_handler.h"
+#include "cycle_count.h"
+
+/**
+ * @brief	Size of the transmit ring buffer attached to g_uart in "main()"
+ */
+#define UART_TX_RING_SIZE	1024u
+
+/**
+ * @brief	Size of the receive ring buffer attached to g_uart in "main()"
+ */
+#define UART_RX_RING_SIZE	2048u
+
+/**
+ * @brief	Sizes of the ring buffers attached to g_uart_16550 in "main()"
+ */
+#define UART_16550_TX_RING_SIZE	512u
+#define UART_16550_RX_RING_SIZE	256u
+
+/**
+ * @brief	Bytes of telemetry lines streamed through each UART by 
+ * 			"uart_test_irq_rate()"
+ */
+#define IRQ_RATE_STREAM_BYTES	4096u
+
+/**
+ * @brief	Largest block sent by "uart_test_prbs()"
+ */
+#define PRBS_MAX_BLOCK			256u
+
+/**
+ * @brief	Time without an echoed byte before "uart_test_prbs()" counts 
+ * 			the rest of a block as lost, 100 ms
+ */
+#define PRBS_TIMEOUT_CYCLES		(SYS_CLK_FREQ / 10u)
+
+/**
+ * @brief	Quiet time on the receiver that marks the start and end of the 
+ * 			test data, 300 ms. Longer than PRBS_TIMEOUT_CYCLES so the echo 
+ * 			never stops in the middle of a test.
+ */
+#define PRBS_IDLE_CYCLES		(SYS_CLK_FREQ / 10u * 3u)
+
+/**
+ * @brief	Round trip latency histogram of "uart_test_prbs()": the first 
+ * 			bucket is under PRBS_LATENCY_FIRST_US and each one after it 
+ * 			doubles, with the last holding everything longer
+ */
+#define PRBS_LATENCY_BUCKETS	8u
+#define PRBS_LATENCY_FIRST_US	256u
+
+/**
+ * @brief	Transmit ring buffer attached to g_uart
+ */
+extern uint8_t g_uart_tx_ring[UART_TX_RING_SIZE];
+
+/**
+ * @brief	Receive ring buffer attached to g_uart
+ */
+extern uint8_t g_uart_rx_ring[UART_RX_RING_SIZE];
+
+extern UART_instance_t g_uart;
+
+/**
+ * @brief	Core16550 instance and its ring buffers
+ */
+extern uart_16550_instance_t g_uart_16550;
+extern uint8_t g_uart_16550_tx_ring[UART_16550_TX_RING_SIZE];
+extern uint8_t g_uart_16550_rx_ring[UART_16550_RX_RING_SIZE];
+
+/**
+ * @brief	Interrupts taken by the g_uart TXRDY handler and the 
+ * 			g_uart_16550 handler
+ */
+extern volatile uint32_t g_uart_tx_irq_count;
+extern volatile uint32_t g_uart_16550_irq_count;
+
+void uart_test_handler(void);
+void uart_test_tx_cycles(void);
+void uart_test_printf_cycles(void);
+void uart_test_prbs(void);
+void uart_test_irq_rate(void);
+void uart_test_display_commands(void);
+void uart_test_display_incorrect_command(void);
+
+#endif /*UART_TEST_H*/
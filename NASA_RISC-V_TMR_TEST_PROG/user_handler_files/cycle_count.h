@@ -0,0 +1,35 @@
+/**
+ * @file	cycle_count.h
+ * @author	Zac Carico
+ * @date	Oct 16 2026
+ * 
+ * @brief	Cycle counter access used to time sections of the test programs
+ */
+
+#ifndef CYCLE_COUNT_H
+#define CYCLE_COUNT_H
+
+#include <stdint.h>
+#include "encoding.h"
+
+/**
+ * @brief	Reads the lower 32 bits of the Mi-V "mcycle" counter
+ * 
+ * @details	The counter runs at SYS_CLK_FREQ, so it wraps after roughly 
+ * 			38 seconds. Differences between two reads are correct as long 
+ * 			as the timed section is shorter than that.
+ * 
+ * @code
+	uint32_t start = get_cycle_count();
+	do_something();
+	uint32_t cycles = get_cycle_count() - start;
+ * @endcode
+ * 
+ * @return	Current cycle count
+ */
+static inline uint32_t get_cycle_count(void)
+{
+	return (uint32_t)read_csr(mcycle);
+}
+
+#endif /*CYCLE_COUNT_H*/
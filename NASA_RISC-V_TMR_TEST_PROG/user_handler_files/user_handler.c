@@ -7,6 +7,24 @@
  */
 
 #include "user_handler.h"
+#include "cmd_protocol.h"
+#include "cycle_count.h"
+#include "uart_printf.h"
+
+/** @brief Hex digit of each nibble value */
+static const char hex_digits[16] = {
+	'0', '1', '2', '3', '4', '5', '6', '7',
+	'8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+};
+
+/**
+ * @brief	Set when "get_single_char_from_user()" returns, as the key may 
+ * 			be followed by a line end that isn't part of the next answer
+ */
+static uint8_t skip_line_end = 0;
+
+static void legacy_int_to_hex_string(uint32_t num, char hex_string[12]);
+static void legacy_int_to_single_byte_string(uint8_t num, char hex_string[5]);
 
 /**
  * @brief	Used to easily perform unit tests of all functions
@@ -40,6 +58,9 @@ void user_handler_unit_test_handler(void)
 			case '3':
 				user_handler_test_bytes();
 				break;
+			case '4':
+				user_handler_test_hex_cycles();
+				break;
 			case 'h':
 				user_handler_display_instructions();
 				break;
@@ -71,6 +92,7 @@ void user_handler_display_instructions(void)
 	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t-1 \t Test getting entire string\n\r");
 	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t-2 \t Test getting decimal\n\r");
 	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t-3 \t Test getting bytes\n\r");
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t-4 \t Compare hex conversion cycles\n\r");
 	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t-h \t Display this menu\n\r");
 	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t-q \t Quit\n\r");
 }
@@ -155,27 +177,104 @@ void user_handler_test_bytes(void)
 	UART_polled_tx_string(&g_uart, (const uint8_t *)hexStr);
 }
 
+/**
+ * @brief	Compares the cycles per byte of the hex conversions with the 
+ * 			divide-based versions they replaced, and of "hexdump()" with 
+ * 			printing a buffer one "int_to_single_byte_string()" at a time.
+ * 
+ * @details	The conversions are timed over HEX_CYCLE_BYTES bytes of data. 
+ * 			The dumps are timed with the transmit ring buffer attached, 
+ * 			flushed before each run, so only the caller's time is counted. 
+ * 			Results are shown in hundredths of a cycle.
+ */
+void user_handler_test_hex_cycles(void)
+{
+	uint32_t words[HEX_CYCLE_BYTES / 4u];
+	uint8_t *data = (uint8_t *)words;
+	char hexStr[12];
+	uint32_t cycles[6];
+	uint32_t start = 0;
+	uint32_t i = 0;
+
+	for(i = 0; i < HEX_CYCLE_BYTES; i++)
+		data[i] = (uint8_t)(i * 37u + 11u);
+
+	start = get_cycle_count();
+	for(i = 0; i < HEX_CYCLE_BYTES; i++)
+		legacy_int_to_single_byte_string(data[i], hexStr);
+	cycles[0] = get_cycle_count() - start;
+
+	start = get_cycle_count();
+	for(i = 0; i < HEX_CYCLE_BYTES; i++)
+		int_to_single_byte_string(data[i], hexStr);
+	cycles[1] = get_cycle_count() - start;
+
+	start = get_cycle_count();
+	for(i = 0; i < HEX_CYCLE_BYTES; i += 4)
+		legacy_int_to_hex_string(words[i / 4u], hexStr);
+	cycles[2] = get_cycle_count() - start;
+
+	start = get_cycle_count();
+	for(i = 0; i < HEX_CYCLE_BYTES; i += 4)
+		int_to_hex_string(words[i / 4u], hexStr);
+	cycles[3] = get_cycle_count() - start;
+
+	UART_tx_flush(&g_uart);
+	start = get_cycle_count();
+	for(i = 0; i < HEX_CYCLE_BYTES; i++)
+	{
+		legacy_int_to_single_byte_string(data[i], hexStr);
+		UART_polled_tx_string(&g_uart, (const uint8_t *)&hexStr[2]);
+		UART_polled_tx_string(&g_uart, (const uint8_t *)" ");
+	}
+	cycles[4] = get_cycle_count() - start;
+
+	UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\r");
+	UART_tx_flush(&g_uart);
+	start = get_cycle_count();
+	hexdump(data, HEX_CYCLE_BYTES);
+	cycles[5] = get_cycle_count() - start;
+	UART_tx_flush(&g_uart);
+
+	for(i = 0; i < 6; i++)
+		cycles[i] = cycles[i] * 100u / HEX_CYCLE_BYTES;
+
+	uart_printf("\n\r\tCYCLES PER BYTE\tOLD\tNEW\n\r"
+				"\tsingle byte\t%u.%02u\t%u.%02u\n\r"
+				"\thex string\t%u.%02u\t%u.%02u\n\r"
+				"\tdump\t\t%u.%02u\t%u.%02u\n\r",
+				cycles[0] / 100u, cycles[0] % 100u, cycles[1] / 100u, cycles[1] % 100u,
+				cycles[2] / 100u, cycles[2] % 100u, cycles[3] / 100u, cycles[3] % 100u,
+				cycles[4] / 100u, cycles[4] % 100u, cycles[5] / 100u, cycles[5] % 100u);
+}
+
 /**
  * @brief	Gets a single character from the user's input
+ * 
+ * @details	Line ends left over from a previous answer are skipped, so a 
+ * 			pasted script can put each answer on its own line. The 
+ * 			character is echoed by the receive interrupt.
+ * 
  * @return	Value of type char (the user's input)
  */
 char get_single_char_from_user(void)
 {
 	uint8_t rx_size=0;
-	uint8_t rx_buff[2];
+	uint8_t rx_buff[1];
 	uint8_t correct_input = 0;
 	UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\r\t> ");
 
+	// Command frames received while waiting are handled here
 	while(correct_input == 0)
 	{
+		cmd_protocol_service();
 		rx_size = UART_get_rx(&g_uart, rx_buff, sizeof(rx_buff));
 
-		if(rx_size > 0)
+		if(rx_size > 0 && rx_buff[0] != RETURN_KEY && rx_buff[0] != NEW_LINE)
 			correct_input = 1;
 	}
-	rx_buff[1] = '\0';
-	UART_polled_tx_string(&g_uart, (const uint8_t *)rx_buff);
 	UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\r\n\r");
+	skip_line_end = 1;
 	return (char)rx_buff[0];
 }
 
@@ -186,37 +285,58 @@ char get_single_char_from_user(void)
  */
 uint8_t get_yes_no_from_user(void)
 {
-	uint8_t rx_size=0;
-	uint8_t rx_buff[2];
-	uint8_t correct_input = 0;
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\r\t> ");
+	char input = get_single_char_from_user();
 
-	while(correct_input == 0)
+	if(input == 'N' || input == 'n')
+		return 0;
+	else
+		return 1;
+}
+
+/**
+ * @brief	Waits for the user to enter a complete line
+ * 
+ * @details	Line assembly, backspace handling and echo are done by the 
+ * 			receive interrupt (see "UART_rx_isr()"), so this only waits 
+ * 			for a line end and copies the line out of the receive ring 
+ * 			buffer. Characters that don't fit in the line buffer are 
+ * 			discarded. An empty line straight after a single character 
+ * 			answer is the line end typed after that key, so it is 
+ * 			dropped and the next line is waited for.
+ * 
+ * @param line		Pointer/array to be filled with the line, without 
+ * 					its line end
+ * @param lineSize	Size of the line array, including the null terminator
+ * 
+ * @return	Number of characters copied into the line array
+ */
+uint16_t get_line_from_user(char* line, uint16_t lineSize)
+{
+	uint16_t length = 0;
+
+	while(1)
 	{
-		rx_size = UART_get_rx(&g_uart, rx_buff, sizeof(rx_buff));
+		while(UART_get_rx_lines(&g_uart) == 0)
+			cmd_protocol_service();
 
-		if(rx_size > 0)
-			correct_input = 1;
+		length = (uint16_t)UART_get_rx_line(&g_uart, (uint8_t *)line, lineSize);
+		if(length > 0 || skip_line_end == 0)
+			break;
+		skip_line_end = 0;
 	}
 
-	rx_buff[1] = '\0';
-	UART_polled_tx_string(&g_uart, (const uint8_t *)rx_buff);
-	UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\r\n\r");
-
-	if(rx_buff[0] == 'N' || rx_buff[0] == 'n')
-		return 0;
-	else
-		return 1;
+	skip_line_end = 0;
+	return length;
 }
 
 /**
  * @brief		Gets a string of characters from the user
  * 
- * @details		Doesn't register the user pressing the ESC_KEY, BACKSPACE_KEY, 
- * 				or TAB_KEY. When the user has entered the maximum amount of 
- * 				characters, or has pressed the ENTER_KEY, it will end the 
- * 				function. If param "spaceEnabled" is false, it will ignore 
- * 				that to
+ * @details		Doesn't register the user pressing the ESC_KEY, or TAB_KEY. 
+ * 				BACKSPACE_KEY erases the last character entered. Characters 
+ * 				past the maximum amount are ignored, and the function 
+ * 				ends when the user presses the ENTER_KEY. If param 
+ * 				"spaceEnabled" is false, spaces are removed from the input.
  * 
  * @code 
  	#define MAX_INPUT 10
@@ -237,10 +357,8 @@ uint8_t get_yes_no_from_user(void)
 void get_string_from_user(uint8_t numChars, uint8_t spaceEnabled, char* input)
 {
 	uint8_t count = 0;
-	uint8_t receivedInput = 0;
-	uint8_t enteredValue = 0;
-	uint8_t rx_size = 0;
-	uint8_t rx_buf[2];
+	uint8_t i = 0;
+	uint8_t length = 0;
 	char numCharsString[4];
 
 	byte_to_dec_string(numChars, numCharsString);
@@ -250,46 +368,27 @@ void get_string_from_user(uint8_t numChars, uint8_t spaceEnabled, char* input)
 	UART_polled_tx_string(&g_uart, (const uint8_t *)" characters:\n\r");
 	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t> ");
 
-	while(receivedInput == 0)
-	{
-		while(enteredValue == 0)
-		{
-			rx_size = UART_get_rx(&g_uart, rx_buf, sizeof(rx_buf));
-			if(rx_size > 0)
-				enteredValue = 1;
-		}
-		rx_buf[1] = '\0';
-		enteredValue = 0;
+	length = (uint8_t)get_line_from_user(input, numChars);
 
-		if(count < numChars - 1)
+	for(i = 0; i < length; i++)
+	{
+		switch(input[i])
 		{
-			switch(rx_buf[0])
-			{
-				case RETURN_KEY:
-				case NEW_LINE:
-					UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\r");
-					receivedInput = 1;
-					break;
-				case BACKSPACE_KEY:
-				case TAB_HORZ_KEY:
-				case ESCAPE_KEY:
-					break;
-				case SPACE_BAR:
-					if(spaceEnabled)
-					{
-						UART_polled_tx_string(&g_uart, (const uint8_t *)rx_buf);
-						input[count] = ' ';
-						count++;
-					}
-					break;
-				default: // assume user entered character
-					UART_polled_tx_string(&g_uart, (const uint8_t *)rx_buf);
-					input[count] = (char)rx_buf[0];
+			case TAB_HORZ_KEY:
+			case ESCAPE_KEY:
+				break;
+			case SPACE_BAR:
+				if(spaceEnabled)
+				{
+					input[count] = ' ';
 					count++;
-					break;
-			}
+				}
+				break;
+			default: // assume user entered character
+				input[count] = input[i];
+				count++;
+				break;
 		}
-		enteredValue = 0;
 	}
 	input[count] = '\0';
 }
@@ -321,54 +420,20 @@ uint32_t get_dec_from_user(uint8_t numDecPlaces)
 {
 	uint32_t input = 0;
 	uint8_t count = 0;
-	uint32_t placeHolder = 1;
-	uint8_t receivedInput = 0;
-	uint8_t enteredValue = 0;
-	uint8_t rx_size = 0;
-	uint8_t rx_buf[2];
+	uint8_t i = 0;
+	uint16_t length = 0;
+	char line[16];
 
 	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t> ");
 
-	while(receivedInput == 0)
-	{
-		while(enteredValue == 0)
-		{
-			rx_size = UART_get_rx(&g_uart, rx_buf, sizeof(rx_buf));
-			if(rx_size > 0)
-				enteredValue = 1;
-		}
-		rx_buf[1] = '\0';
-		enteredValue = 0;
+	length = get_line_from_user(line, sizeof(line));
 
-		if(count < numDecPlaces)
-		{
-			switch(rx_buf[0])
-			{
-				case RETURN_KEY:
-				case NEW_LINE:
-					UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\r");
-					receivedInput = 1;
-					break;
-				case BACKSPACE_KEY:
-				case TAB_HORZ_KEY:
-				case ESCAPE_KEY:
-				case SPACE_BAR:
-					break;
-				default:
-					if(rx_buf[0] >= '0' && rx_buf[0] <= '9') //Look only for numbers
-					{
-						UART_polled_tx_string(&g_uart, (const uint8_t *)rx_buf);
-						input += (rx_buf[0] - '0') * placeHolder;
-						count++;
-						placeHolder *= 10;
-					}
-					break;
-			}
-		}
-		else if(rx_buf[0] == RETURN_KEY || rx_buf[0] == NEW_LINE)
+	for(i = 0; i < length && count < numDecPlaces; i++)
+	{
+		if(line[i] >= '0' && line[i] <= '9') //Look only for numbers
 		{
-			UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\r");
-			receivedInput = 1;
+			input = input * 10 + (line[i] - '0');
+			count++;
 		}
 	}
 
@@ -383,8 +448,6 @@ uint32_t get_dec_from_user(uint8_t numDecPlaces)
  * 			maximum amount of bytes the user can actually input
  * 			without overflow is 4
  * 
- * @warning	This may not work correctly, run the unit test to verify
- * 
  * @param numBytes	Number of bytes for the user to input
  * 
  * @return 	data entered by user
@@ -392,11 +455,9 @@ uint32_t get_dec_from_user(uint8_t numDecPlaces)
 uint32_t get_bytes_from_user(uint8_t numBytes)
 {
 	uint32_t input = 0;
-	uint8_t enteredValue = 0;
-	uint8_t userFinished = 0;
-	uint8_t rx_size = 0;
-	uint16_t numPlaces = numBytes * 2;
-	uint8_t rx_buf[2] = {0};
+	uint8_t i = 0;
+	uint16_t length = 0;
+	char line[32];
 	char numByteStr[4];
 
 	byte_to_dec_string(numBytes, numByteStr);
@@ -406,79 +467,16 @@ uint32_t get_bytes_from_user(uint8_t numBytes)
 	UART_polled_tx_string(&g_uart, (const uint8_t *)" bytes with the first entry being the MSB.\n\r\tSpaces can be used as separators.\n\r");
 	UART_polled_tx_string(&g_uart, (const uint8_t *)"\t> 0x");
 
-	while(userFinished == 0)
-	{
+	length = get_line_from_user(line, sizeof(line));
 
-		while(enteredValue == 0)
-		{
-			rx_size = UART_get_rx(&g_uart, rx_buf, sizeof(rx_buf));
-			if(rx_size > 0)
-				enteredValue = 1;
-		}
-		rx_buf[1] = '\0';
-		enteredValue = 0;
-
-		if((rx_buf[0] >= '0' && rx_buf[0] <= '9') ||
-		   (rx_buf[0] >= 'a' && rx_buf[0] <= 'f') ||
-		   (rx_buf[0] >= 'A' && rx_buf[0] <= 'F'))
-			UART_polled_tx_string(&g_uart, (const uint8_t *)rx_buf);
-		else if(rx_buf[0] == SPACE_BAR)
-			UART_polled_tx_string(&g_uart, (const uint8_t *)" ");
-		else if(rx_buf[0] == RETURN_KEY)
-			UART_polled_tx_string(&g_uart, (const uint8_t *)"\n\r");
-
-		switch(rx_buf[0])
-		{
-			case RETURN_KEY:
-			case NEW_LINE:
-				return input;
-				break;
-			case '0':
-			case '1':
-			case '2':
-			case '3':
-			case '4':
-			case '5':
-			case '6':
-			case '7':
-			case '8':
-			case '9':
-				input = input << 4;
-				input += rx_buf[0] - '0';
-				break;
-			case 'a':
-			case 'A':
-				input = input << 4;
-				input += 0x0A;
-				break;
-			case 'b':
-			case 'B':
-				input = input << 4;
-				input += 0x0B;
-				break;
-			case 'c':
-			case 'C':
-				input = input << 4;
-				input += 0x0C;
-				break;
-			case 'd':
-			case 'D':
-				input = input << 4;
-				input += 0x0D;
-				break;
-			case 'e':
-			case 'E':
-				input = input << 4;
-				input += 0x0E;
-				break;
-			case 'f':
-			case 'F':
-				input = input << 4;
-				input += 0x0F;
-				break;
-			default:
-				break;
-		}
+	for(i = 0; i < length; i++)
+	{
+		if(line[i] >= '0' && line[i] <= '9')
+			input = (input << 4) + (line[i] - '0');
+		else if(line[i] >= 'a' && line[i] <= 'f')
+			input = (input << 4) + (line[i] - 'a' + 0x0A);
+		else if(line[i] >= 'A' && line[i] <= 'F')
+			input = (input << 4) + (line[i] - 'A' + 0x0A);
 	}
 
 	return input;
@@ -505,10 +503,122 @@ void byte_to_dec_string(uint8_t byte, char dec_string[4])
  * 
  * @param num			The 32-but integer to convert to a  
  * 						string representation of bytes
- * @param hex_string	Array with 12 elements representing 
- * 						a 32-bit integer as a string of bytes
+ * @param hex_string	Array with 12 elements that is filled with 
+ * 						"0x" and 8 hex digits
  */
 void int_to_hex_string(uint32_t num, char hex_string[12])
+{
+	int8_t i;
+
+	hex_string[11] = '\0';
+	hex_string[10] = '\0';
+	for(i = 9; i >= 2; i--)
+	{
+		hex_string[i] = hex_digits[num & 0xF];
+		num >>= 4;
+	}
+	hex_string[1] = 'x';
+	hex_string[0] = '0';
+}
+
+/**
+ * @brief	Converts a byte into a string representation
+ * 
+ * @param num			Byte to convert into string representation
+ * @param hex_string	Array with 5 elements that represents a byte 
+ * 						in string a format
+ */
+void int_to_single_byte_string(uint8_t num, char hex_string[5])
+{
+	hex_string[4] = '\0';
+	hex_string[3] = hex_digits[num & 0xF];
+	hex_string[2] = hex_digits[num >> 4];
+	hex_string[1] = 'x';
+	hex_string[0] = '0';
+}
+
+/**
+ * @brief	Prints a buffer as rows of hex bytes, each row starting 
+ * 			with the offset of its first byte
+ * 
+ * @details	Each row is built in a stack buffer and sent with one 
+ * 			"UART_send()" call, 16 bytes of data at a time.
+ * 
+ * @code
+	\t0000: 00 11 22 33 44 55 66 77 88 99 AA BB CC DD EE FF
+	\t0010: 01 02
+ * @endcode
+ * 
+ * @param buf	Data to print
+ * @param len	Number of bytes in buf
+ */
+void hexdump(const uint8_t *buf, uint32_t len)
+{
+	char line[HEXDUMP_LINE_SIZE];
+	uint32_t offset = 0;
+
+	while(offset < len)
+	{
+		uint32_t count = len - offset;
+		uint16_t pos = 0;
+		uint32_t i;
+
+		if(count > HEXDUMP_BYTES_PER_LINE)
+			count = HEXDUMP_BYTES_PER_LINE;
+
+		line[pos++] = '\t';
+		line[pos++] = hex_digits[(offset >> 12) & 0xF];
+		line[pos++] = hex_digits[(offset >> 8) & 0xF];
+		line[pos++] = hex_digits[(offset >> 4) & 0xF];
+		line[pos++] = hex_digits[offset & 0xF];
+		line[pos++] = ':';
+		for(i = 0; i < count; i++)
+		{
+			uint8_t byte = buf[offset + i];
+			line[pos++] = ' ';
+			line[pos++] = hex_digits[byte >> 4];
+			line[pos++] = hex_digits[byte & 0xF];
+		}
+		line[pos++] = '\n';
+		line[pos++] = '\r';
+
+		UART_send(&g_uart, (const uint8_t *)line, pos);
+		offset += count;
+	}
+}
+
+/**
+ * @brief	Converts a 32-bit integer into a decimal string without 
+ * 			leading zeros
+ * 
+ * @param num			The 32-bit integer to convert
+ * @param dec_string	Array with 11 elements that is filled with 
+ * 						the decimal representation of num
+ */
+void int_to_dec_string(uint32_t num, char dec_string[11])
+{
+	char digits[10];
+	uint8_t numDigits = 0;
+	uint8_t i = 0;
+
+	do
+	{
+		digits[numDigits] = num % 10 + '0';
+		num /= 10;
+		numDigits++;
+	} while(num != 0);
+
+	for(i = 0; i < numDigits; i++)
+		dec_string[i] = digits[numDigits - 1 - i];
+	dec_string[numDigits] = '\0';
+}
+
+/**
+ * @brief	Divide-based "int_to_hex_string()" that the table version 
+ * 			replaced, kept so "user_handler_test_hex_cycles()" can time 
+ * 			it. Prints ':' to '?' for digits above 9.
+ */
+static void legacy_int_to_hex_string(uint32_t num, char hex_string[12])
 {
 	hex_string[11] = '\0';
 	hex_string[10] = num % 0x10 + '0';
@@ -525,13 +635,11 @@ void int_to_hex_string(uint32_t num, char hex_string[12])
 }
 
 /**
- * @brief	Converts a byte into a string representation
- * 
- * @param num			Byte to convert into string representation
- * @param hex_string	Array with 5 elements that represents a byte 
- * 						in string a format
+ * @brief	Divide-based "int_to_single_byte_string()" that the table 
+ * 			version replaced, kept so "user_handler_test_hex_cycles()" 
+ * 			can time it. Prints ':' to '?' for digits above 9.
  */
-void int_to_single_byte_string(uint8_t num, char hex_string[5])
+static void legacy_int_to_single_byte_string(uint8_t num, char hex_string[5])
 {
 	hex_string[4] = '\0';
 	hex_string[3] = num % 0x10 + '0';
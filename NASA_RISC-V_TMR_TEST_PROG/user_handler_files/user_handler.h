@@ -26,6 +26,15 @@ typedef enum {
 	SPACE_BAR = 0x20
 } KEY_TABLE;
 
+/** @brief Bytes of data timed by "user_handler_test_hex_cycles()" */
+#define HEX_CYCLE_BYTES			64u
+
+/** @brief Data bytes in each row printed by "hexdump()" */
+#define HEXDUMP_BYTES_PER_LINE	16u
+
+/** @brief Characters in a row printed by "hexdump()": tab, offset, bytes and line end */
+#define HEXDUMP_LINE_SIZE		(1u + 5u + (HEXDUMP_BYTES_PER_LINE * 3u) + 2u)
+
 /**
  * @note	Global variable initialized in "main()"
  */
@@ -38,14 +47,18 @@ void user_handler_test_yes_no(void);
 void user_handler_test_string(void);
 void user_handler_test_decimal(void);
 void user_handler_test_bytes(void);
+void user_handler_test_hex_cycles(void);
 char get_single_char_from_user(void);
 uint8_t get_yes_no_from_user(void);
+uint16_t get_line_from_user(char* line, uint16_t lineSize);
 void get_string_from_user(uint8_t numChars, uint8_t spaceEnabled, char* input);
 uint32_t get_dec_from_user(uint8_t numDecPlaces);
 uint32_t get_bytes_from_user(uint8_t numBytes);
 void byte_to_dec_string(uint8_t byte, char dec_string[4]);
 void int_to_hex_string(uint32_t num, char hex_string[12]);
 void int_to_single_byte_string(uint8_t num, char hex_string[5]);
+void int_to_dec_string(uint32_t num, char dec_string[11]);
+void hexdump(const uint8_t *buf, uint32_t len);
 
 
 #endif /*USER_HANDLER_H*/
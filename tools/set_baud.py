@@ -0,0 +1,194 @@
+#!/usr/bin/env python3
+"""Negotiates a faster console baud rate with NASA_RISC-V_TMR_TEST_PROG.
+
+Sends CMD_SET_BAUD at the current rate and prints the baud value, actual
+rate and error the firmware reports. If the firmware accepts, both ends
+switch and CMD_BAUD_CONFIRM carries a PRBS-15 pattern that the firmware
+checks and echoes. When the pattern doesn't come back within the confirm
+time both ends stay at the current rate. On success the port is left at the
+new rate for the next program to open.
+
+Usage:
+    tools/set_baud.py /dev/ttyUSB0 460800 [current baud, default 115200]
+"""
+
+import os
+import select
+import struct
+import sys
+import termios
+import time
+
+CMD_GET_STATS = 6
+CMD_SET_BAUD = 7
+CMD_BAUD_CONFIRM = 8
+CMD_RESPONSE_FLAG = 0x80
+CMD_OK = 0
+CMD_ERR_PARAM = 4
+
+BAUD_PATTERN_LENGTH = 64
+PRBS15_SEED = 0x7FFF
+
+# Longer than the firmware's 1 s BAUD_CONFIRM_CYCLES
+RESPONSE_SECONDS = 1.5
+
+# Gives the firmware time to switch after the CMD_SET_BAUD response
+SWITCH_SECONDS = 0.05
+
+
+def crc16_ccitt(data):
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_encode(data):
+    out = bytearray([0])
+    code_idx = 0
+    for byte in data:
+        if byte == 0:
+            out[code_idx] = len(out) - code_idx
+            code_idx = len(out)
+            out.append(0)
+        else:
+            out.append(byte)
+            if len(out) - code_idx == 0xFF:
+                out[code_idx] = 0xFF
+                code_idx = len(out)
+                out.append(0)
+    out[code_idx] = len(out) - code_idx
+    return bytes(out)
+
+
+def cobs_decode(encoded):
+    out = bytearray()
+    idx = 0
+    while idx < len(encoded):
+        code = encoded[idx]
+        if code == 0 or idx + code > len(encoded):
+            return None
+        out += encoded[idx + 1:idx + code]
+        idx += code
+        if code != 0xFF and idx < len(encoded):
+            out.append(0)
+    return bytes(out)
+
+
+def prbs15(length, state=PRBS15_SEED):
+    """Same sequence as prbs_fill() with PRBS_15 on the target."""
+    out = bytearray()
+    for _ in range(length):
+        byte = 0
+        for i in range(8):
+            bit = ((state >> 14) ^ (state >> 13)) & 1
+            state = ((state << 1) | bit) & 0x7FFF
+            byte |= bit << i
+        out.append(byte)
+    return bytes(out)
+
+
+def open_port(path, baud):
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+    attrs = termios.tcgetattr(fd)
+    attrs[0] = 0                                            # iflag
+    attrs[1] = 0                                            # oflag
+    attrs[2] = termios.CS8 | termios.CREAD | termios.CLOCAL  # cflag
+    attrs[3] = 0                                            # lflag
+    attrs[6][termios.VMIN] = 0
+    attrs[6][termios.VTIME] = 0
+    termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    set_speed(fd, baud)
+    return fd
+
+
+def set_speed(fd, baud):
+    speed = getattr(termios, "B%d" % baud, None)
+    if speed is None:
+        sys.exit("%d baud is not supported by this host" % baud)
+    attrs = termios.tcgetattr(fd)
+    attrs[4] = attrs[5] = speed
+    termios.tcsetattr(fd, termios.TCSADRAIN, attrs)
+    termios.tcflush(fd, termios.TCIFLUSH)
+
+
+def send_request(fd, seq, cmd, params):
+    message = bytes([seq, cmd]) + params
+    message += struct.pack("<H", crc16_ccitt(message))
+    os.write(fd, b"\0" + cobs_encode(message) + b"\0")
+    termios.tcdrain(fd)
+
+
+def read_response(fd, seq, cmd):
+    """Returns (status, data) of the matching response, or None on timeout.
+    Console text and other frames in between are skipped."""
+    deadline = time.monotonic() + RESPONSE_SECONDS
+    frame = None
+    while True:
+        remaining = deadline - time.monotonic()
+        if remaining <= 0:
+            return None
+        ready, _, _ = select.select([fd], [], [], remaining)
+        if not ready:
+            continue
+        for byte in os.read(fd, 4096):
+            if byte != 0:
+                if frame is not None:
+                    frame.append(byte)
+                continue
+            if not frame:
+                frame = bytearray()
+                continue
+            message = cobs_decode(bytes(frame))
+            frame = None
+            if (message is None or len(message) < 5 or
+                    crc16_ccitt(message[:-2]) != struct.unpack("<H", message[-2:])[0]):
+                continue
+            if message[0] == seq and message[1] == cmd | CMD_RESPONSE_FLAG:
+                return message[2], message[3:-2]
+
+
+def main():
+    if len(sys.argv) < 3:
+        sys.exit(__doc__)
+    baud = int(sys.argv[2])
+    current = int(sys.argv[3]) if len(sys.argv) > 3 else 115200
+    fd = open_port(sys.argv[1], current)
+    set_speed(fd, baud)          # fail early if the host can't do the rate
+    set_speed(fd, current)
+
+    send_request(fd, 1, CMD_SET_BAUD, struct.pack("<I", baud))
+    response = read_response(fd, 1, CMD_SET_BAUD)
+    if response is None:
+        sys.exit("no response to CMD_SET_BAUD at %d baud" % current)
+
+    status, data = response
+    if len(data) == 8:
+        value, actual, error = struct.unpack("<HIh", data)
+        print("baud value %d, actual %d baud, error %+.2f%%" % (value, actual, error / 100))
+    if status != CMD_OK:
+        sys.exit("firmware refused %d baud (status %d)" % (baud, status))
+
+    time.sleep(SWITCH_SECONDS)
+    set_speed(fd, baud)
+    pattern = prbs15(BAUD_PATTERN_LENGTH)
+    send_request(fd, 2, CMD_BAUD_CONFIRM, pattern)
+    response = read_response(fd, 2, CMD_BAUD_CONFIRM)
+    if response == (CMD_OK, pattern):
+        print("link running at %d baud" % baud)
+        return
+
+    # The firmware falls back once its confirm time runs out
+    time.sleep(RESPONSE_SECONDS)
+    set_speed(fd, current)
+    send_request(fd, 3, CMD_GET_STATS, b"")
+    if read_response(fd, 3, CMD_GET_STATS) is None:
+        sys.exit("test pattern failed and no response at %d baud" % current)
+    sys.exit("test pattern failed, link back at %d baud" % current)
+
+
+if __name__ == "__main__":
+    main()
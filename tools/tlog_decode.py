@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+"""Expands tokenized log records sent by NASA_RISC-V_TMR_TEST_PROG.
+
+The firmware, built with USE_TLOG=1, sends each TLOG call as a 0x00
+delimited COBS frame holding [0xFE][id u16][arg u32 ...]. The ID is the
+address of the format string in the .tlog_fmt section of the .elf. Text
+outside frames is printed unchanged, and frames that aren't log records
+(command protocol responses) are printed as hex. Responses start with
+their sequence number, which the firmware keeps at or below 0xFD, so the
+tag tells the two apart.
+
+Usage:
+    stty -F /dev/ttyUSB0 115200 raw -echo
+    tools/tlog_decode.py Debug/NASA_RISC-V_TMR_TEST_PROG.elf /dev/ttyUSB0
+
+Reads standard input when no input is given, so a capture can be
+decoded later with "tlog_decode.py app.elf < capture.bin".
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+TLOG_FRAME_TAG = 0xFE
+TLOG_SECTION = b".tlog_fmt"
+
+# Same conversions as tlog_print() on the target
+SPEC_RE = re.compile(r"%(0?)([1-9]?)([duxXc%])")
+
+
+def load_formats(elf_path):
+    """Returns {id: format string} read from the .tlog_fmt section."""
+    with open(elf_path, "rb") as f:
+        elf = f.read()
+
+    if elf[:4] != b"\x7fELF" or elf[5] != 1:
+        sys.exit("%s: not a little endian ELF file" % elf_path)
+
+    if elf[4] == 1:
+        shoff, = struct.unpack_from("<I", elf, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", elf, 0x2E)
+        sh_fmt = "<IIIIIIIIII"
+    else:
+        shoff, = struct.unpack_from("<Q", elf, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", elf, 0x3A)
+        sh_fmt = "<IIQQQQIIQQ"
+
+    sections = [struct.unpack_from(sh_fmt, elf, shoff + i * shentsize)
+                for i in range(shnum)]
+    strtab_offset = sections[shstrndx][4]
+
+    for name, _, _, addr, offset, size, _, _, _, _ in sections:
+        end = elf.index(b"\0", strtab_offset + name)
+        if elf[strtab_offset + name:end] != TLOG_SECTION:
+            continue
+
+        data = elf[offset:offset + size]
+        formats = {}
+        start = 0
+        while start < len(data):
+            if data[start] == 0:
+                start += 1
+                continue
+            end = data.index(b"\0", start)
+            formats[addr + start] = data[start:end].decode("latin-1")
+            start = end + 1
+        return formats
+
+    sys.exit("%s: no %s section, was it built with USE_TLOG=1?"
+             % (elf_path, TLOG_SECTION.decode()))
+
+
+def cobs_decode(encoded):
+    """Returns the decoded message, or None if the encoding is bad."""
+    decoded = bytearray()
+    idx = 0
+    while idx < len(encoded):
+        code = encoded[idx]
+        if code == 0 or idx + code > len(encoded):
+            return None
+        decoded += encoded[idx + 1:idx + code]
+        idx += code
+        if code != 0xFF and idx < len(encoded):
+            decoded.append(0)
+    return bytes(decoded)
+
+
+def format_record(fmt, args):
+    """Formats a record the way tlog_print() would on the target."""
+    args = list(args)
+
+    def convert(match):
+        pad, width, conv = match.groups()
+        if conv == "%":
+            return "%"
+        if not args:
+            return match.group(0)
+        value = args.pop(0)
+        if conv == "c":
+            text = chr(value & 0xFF)
+        elif conv == "d":
+            text = str(value - (1 << 32) if value & 0x80000000 else value)
+        elif conv == "u":
+            text = str(value)
+        else:
+            text = ("%x" if conv == "x" else "%X") % value
+        width = int(width or 0)
+        if pad and text.startswith("-"):
+            return "-" + text[1:].rjust(width - 1, "0")
+        return text.rjust(width, "0" if pad else " ")
+
+    return SPEC_RE.sub(convert, fmt)
+
+
+def decode_frame(message, formats):
+    if len(message) >= 3 and message[0] == TLOG_FRAME_TAG and (len(message) - 3) % 4 == 0:
+        record_id, = struct.unpack_from("<H", message, 1)
+        args = struct.unpack_from("<%dI" % ((len(message) - 3) // 4), message, 3)
+        if record_id in formats:
+            return format_record(formats[record_id], args)
+        return "<tlog unknown id %u args %s>\n" % (record_id, list(args))
+    return "<frame %s>\n" % message.hex(" ")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("elf", help="firmware .elf built with USE_TLOG=1")
+    parser.add_argument("input", nargs="?", help="serial device or capture file (default: stdin)")
+    opts = parser.parse_args()
+
+    formats = load_formats(opts.elf)
+    stream = open(opts.input, "rb", buffering=0) if opts.input else sys.stdin.buffer
+    out = sys.stdout
+
+    frame = None
+    while True:
+        chunk = stream.read(256) if opts.input else stream.read1(256)
+        if not chunk:
+            break
+        for byte in chunk:
+            if frame is None:
+                if byte == 0:
+                    frame = bytearray()
+                else:
+                    out.write(chr(byte))
+            elif byte == 0:
+                if frame:
+                    message = cobs_decode(bytes(frame))
+                    out.write(decode_frame(message, formats) if message is not None
+                              else "<bad frame %s>\n" % bytes(frame).hex(" "))
+                    frame = None
+                # An empty frame is the start delimiter of the next one
+            else:
+                frame.append(byte)
+        out.flush()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+"""Console and host echo for the UART PRBS test of NASA_RISC-V_TMR_TEST_PROG.
+
+Works as a plain line terminal: console output is printed and each line
+typed is sent with a CR. Once the firmware prints "PRBS START" every byte
+received is echoed straight back until the test data stops for
+IDLE_SECONDS, after which it is a terminal again and the results show.
+
+Usage:
+    tools/uart_echo.py /dev/ttyUSB0 [baud]
+"""
+
+import os
+import select
+import sys
+import termios
+import time
+
+START_MARKER = b"PRBS START\n\r"
+
+# Shorter than the firmware's 300 ms PRBS_IDLE_CYCLES, longer than its
+# 100 ms PRBS_TIMEOUT_CYCLES
+IDLE_SECONDS = 0.2
+
+
+def open_port(path, baud):
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+    attrs = termios.tcgetattr(fd)
+    attrs[0] = 0                                            # iflag
+    attrs[1] = 0                                            # oflag
+    attrs[2] = termios.CS8 | termios.CREAD | termios.CLOCAL  # cflag
+    attrs[3] = 0                                            # lflag
+    speed = getattr(termios, "B%d" % baud)
+    attrs[4] = attrs[5] = speed
+    attrs[6][termios.VMIN] = 0
+    attrs[6][termios.VTIME] = 0
+    termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return fd
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit(__doc__)
+    baud = int(sys.argv[2]) if len(sys.argv) > 2 else 115200
+    port = open_port(sys.argv[1], baud)
+    stdin = sys.stdin.fileno()
+
+    echoing = False
+    last_rx = None
+    recent = b""
+
+    while True:
+        ready, _, _ = select.select([port, stdin], [], [], IDLE_SECONDS / 4)
+
+        if port in ready:
+            data = os.read(port, 4096)
+            if not echoing:
+                # The marker can arrive split over reads and followed by
+                # test data in the same read, so search what has come in
+                # since the last read along with the tail of the one before
+                recent += data
+                found = recent.find(START_MARKER)
+                if found < 0:
+                    sys.stdout.write(data.decode("latin-1"))
+                    sys.stdout.flush()
+                    recent = recent[-(len(START_MARKER) - 1):]
+                    data = b""
+                else:
+                    end = found + len(START_MARKER)
+                    console = data[:len(data) - (len(recent) - end)]
+                    sys.stdout.write(console.decode("latin-1"))
+                    print("[echoing test data]", flush=True)
+                    # The idle time only counts once test data has started
+                    echoing = True
+                    last_rx = None
+                    data = recent[end:]
+                    recent = b""
+            if echoing and data:
+                os.write(port, data)
+                last_rx = time.monotonic()
+        elif echoing and last_rx is not None and time.monotonic() - last_rx > IDLE_SECONDS:
+            echoing = False
+            print("[echo finished]", flush=True)
+
+        if stdin in ready:
+            line = sys.stdin.readline()
+            if not line:
+                break
+            os.write(port, line.rstrip("\n").encode("latin-1") + b"\r")
+
+
+if __name__ == "__main__":
+    main()